@@ -10,8 +10,11 @@
 #include <arch/x86/cpu/gdt.h>
 #include <arch/x86/cpu/idt.h>
 #include <arch/x86/cpu/int.h>
+#include <arch/x86/cpu/lapic.h>
 #include <arch/x86/cpu/lpic.h>
+#include <arch/x86/cpu/msr.h>
 #include <arch/x86/cpu/regs.h>
+#include <arch/x86/cpu/tsc.h>
 #include <arch/x86/cpu/tss.h>
 #include <arch/x86/cpu/types.h>
 
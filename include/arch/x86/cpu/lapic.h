@@ -0,0 +1,79 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef ARCH_X86_CPU_LAPIC_H_
+#define ARCH_X86_CPU_LAPIC_H_
+
+/**
+ * @addtogroup x86-cpu-lapic x86 Local APIC
+ * @ingroup x86
+ *
+ * @brief x86 Local APIC
+ */
+/**@{*/
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Physical base address of Local APIC registers.
+ */
+#define LAPIC_BASE_PHYS 0xfee00000
+
+/**
+ * @name Local APIC Registers
+ */
+/**@{*/
+#define LAPIC_ID 0x020        /** Local APIC ID                  */
+#define LAPIC_TPR 0x080       /** Task Priority                  */
+#define LAPIC_EOI 0x0b0       /** End of Interrupt               */
+#define LAPIC_SVR 0x0f0       /** Spurious Interrupt Vector      */
+#define LAPIC_ESR 0x280       /** Error Status                   */
+#define LAPIC_ICR_LOW 0x300   /** Interrupt Command (bits 0-31)  */
+#define LAPIC_ICR_HIGH 0x310  /** Interrupt Command (bits 32-63) */
+#define LAPIC_LVT_TIMER 0x320 /** LVT Timer                      */
+#define LAPIC_LVT_LINT0 0x350 /** LVT LINT0                      */
+#define LAPIC_LVT_LINT1 0x360 /** LVT LINT1                      */
+#define LAPIC_LVT_ERROR 0x370 /** LVT Error                      */
+/**@}*/
+
+/**
+ * @brief Software enable bit of the spurious interrupt vector register.
+ */
+#define LAPIC_SVR_ENABLE (1 << 8)
+
+/**
+ * @name Local Vector Table Entry Fields
+ */
+/**@{*/
+#define LAPIC_LVT_EXTINT (7 << 8)  /** ExtINT delivery mode. */
+#define LAPIC_LVT_NMI (4 << 8)     /** NMI delivery mode.    */
+#define LAPIC_LVT_MASKED (1 << 16) /** Masked.               */
+/**@}*/
+
+/**
+ * @name Interrupt Command Register Fields
+ */
+/**@{*/
+#define LAPIC_ICR_FIXED (0 << 8)         /** Fixed delivery mode.       */
+#define LAPIC_ICR_INIT (5 << 8)          /** INIT delivery mode.        */
+#define LAPIC_ICR_STARTUP (6 << 8)       /** Start-up delivery mode.    */
+#define LAPIC_ICR_PENDING (1 << 12)      /** Delivery pending.          */
+#define LAPIC_ICR_ASSERT (1 << 14)       /** Assert level.              */
+#define LAPIC_ICR_LEVEL (1 << 15)        /** Level triggered.           */
+#define LAPIC_ICR_ALL_BUT_SELF (3 << 18) /** All cores but the sender.  */
+/**@}*/
+
+/**
+ * @brief CPUID feature flag for an on-chip Local APIC.
+ */
+#define CPUID_FEATURES_EDX_APIC (1 << 9)
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* ARCH_X86_CPU_LAPIC_H_ */
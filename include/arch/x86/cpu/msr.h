@@ -0,0 +1,113 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef ARCH_X86_CPU_MSR_H_
+#define ARCH_X86_CPU_MSR_H_
+
+/**
+ * @addtogroup x86-cpu-msr x86 MSR
+ * @ingroup x86
+ *
+ * @brief x86 Model-Specific Registers
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/cc.h>
+#ifndef _ASM_FILE_
+#include <stdint.h>
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @name Model-Specific Registers
+ */
+/**@{*/
+#define MSR_IA32_SYSENTER_CS 0x174  /** SYSENTER code segment.  */
+#define MSR_IA32_SYSENTER_ESP 0x175 /** SYSENTER stack pointer. */
+#define MSR_IA32_SYSENTER_EIP 0x176 /** SYSENTER entry point.   */
+/**@}*/
+
+/**
+ * @name CPUID Leaves
+ */
+/**@{*/
+#define CPUID_LEAF_FEATURES 1 /** Processor features. */
+/**@}*/
+
+/**
+ * @name CPUID Feature Flags (EDX)
+ */
+/**@{*/
+#define CPUID_FEATURES_EDX_MSR (1 << 5)   /** RDMSR/WRMSR instructions.      */
+#define CPUID_FEATURES_EDX_SEP (1 << 11)  /** SYSENTER/SYSEXIT instructions. */
+#define CPUID_FEATURES_EDX_FXSR (1 << 24) /** FXSAVE/FXRSTOR instructions.   */
+#define CPUID_FEATURES_EDX_SSE (1 << 25)  /** SSE extensions.                */
+/**@}*/
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief Queries processor information.
+ *
+ * @param leaf Target CPUID leaf.
+ * @param eax  Storage location for value of EAX register.
+ * @param ebx  Storage location for value of EBX register.
+ * @param ecx  Storage location for value of ECX register.
+ * @param edx  Storage location for value of EDX register.
+ */
+static inline void cpuid(uint32_t leaf, uint32_t *eax, uint32_t *ebx,
+                         uint32_t *ecx, uint32_t *edx)
+{
+    asm volatile("cpuid"
+                 : "=a"(*eax), "=b"(*ebx), "=c"(*ecx), "=d"(*edx)
+                 : "a"(leaf), "c"(0));
+}
+
+/**
+ * @brief Reads a model-specific register.
+ *
+ * @param msr Number of the target model-specific register.
+ *
+ * @returns The value of the target model-specific register.
+ */
+static inline uint64_t msr_read(uint32_t msr)
+{
+    uint32_t lo;
+    uint32_t hi;
+    asm volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+    return (((uint64_t)hi << 32) | lo);
+}
+
+/**
+ * @brief Writes to a model-specific register.
+ *
+ * @param msr   Number of the target model-specific register.
+ * @param value Value to write.
+ */
+static inline void msr_write(uint32_t msr, uint64_t value)
+{
+    const uint32_t lo = (uint32_t)value;
+    const uint32_t hi = (uint32_t)(value >> 32);
+    asm volatile("wrmsr" : : "c"(msr), "a"(lo), "d"(hi));
+}
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* ARCH_X86_CPU_MSR_H_ */
@@ -27,4 +27,24 @@
 #define EFLAGS_RF (1 << 16)    /** Resume Flag           */
 /**@}*/
 
+/**
+ * @name Control Register 0
+ */
+/**@{*/
+#define CR0_PE (1 << 0)   /** Protection Enable   */
+#define CR0_MP (1 << 1)   /** Monitor Coprocessor */
+#define CR0_EM (1 << 2)   /** Emulation           */
+#define CR0_TS (1 << 3)   /** Task Switched       */
+#define CR0_NE (1 << 5)   /** Numeric Error       */
+#define CR0_PG 0x80000000 /** Paging              */
+/**@}*/
+
+/**
+ * @name Control Register 4
+ */
+/**@{*/
+#define CR4_OSFXSR (1 << 9)      /** FXSAVE/FXRSTOR Support     */
+#define CR4_OSXMMEXCPT (1 << 10) /** Unmasked SIMD Exceptions   */
+/**@}*/
+
 #endif /* _ARCH_X86_REGS_H_ */
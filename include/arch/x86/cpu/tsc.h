@@ -0,0 +1,51 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef ARCH_X86_CPU_TSC_H_
+#define ARCH_X86_CPU_TSC_H_
+
+/**
+ * @addtogroup x86-cpu-tsc x86 TSC
+ * @ingroup x86
+ *
+ * @brief x86 Timestamp Counter
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/cc.h>
+#ifndef _ASM_FILE_
+#include <stdint.h>
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief Reads the timestamp counter.
+ *
+ * @returns The current value of the timestamp counter.
+ */
+static inline uint64_t tsc_read(void)
+{
+    uint32_t lo;
+    uint32_t hi;
+    asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return (((uint64_t)hi << 32) | lo);
+}
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* ARCH_X86_CPU_TSC_H_ */
@@ -142,6 +142,19 @@ struct pde {
 
 #ifndef _ASM_FILE_
 
+/**
+ * @brief Reads the CR3 register.
+ *
+ * @returns The value of the CR3 register, which is the physical address of
+ * the page directory that is loaded.
+ */
+static inline paddr_t cr3_read(void)
+{
+    paddr_t cr3;
+    __asm__ volatile("movl %%cr3, %0" : "=r"(cr3));
+    return (cr3);
+}
+
 /**
  * @brief Loads changes in the TLB.
  *
@@ -7,6 +7,7 @@
 #define DEV_UART_H_
 
 #ifndef _ASM_FILE_
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #endif /* _ASM_FILE_ */
@@ -41,6 +42,24 @@ extern int uart_init(uintptr_t addr, uint16_t baud);
  */
 extern void uart_write(const char *buf, size_t len);
 
+/**
+ * @brief Writes a buffer on the UART device without blocking.
+ *
+ * @param buf Target buffer.
+ * @param len Length of the buffer.
+ *
+ * @return The number of bytes written, which may be zero if the transmitter
+ * is busy.
+ */
+extern size_t uart_write_nonblock(const char *buf, size_t len);
+
+/**
+ * @brief Enables or disables the transmitter interrupt of the UART device.
+ *
+ * @param enable Enable interrupt?
+ */
+extern void uart_tx_interrupt(bool enable);
+
 #endif /* _ASM_FILE_ */
 
 #endif /* DEV_UART_H_ */
@@ -23,6 +23,16 @@
  */
 #define KERNEL_TIMER_FREQUENCY 100
 
+/**
+ * @brief Maximum number of cores that the kernel brings up.
+ */
+#define KERNEL_CORES_MAX 8
+
+/**
+ * @brief Number of kernel threads that serve forwarded kernel calls.
+ */
+#define KERNEL_KCALL_HANDLERS 4
+
 /*============================================================================*/
 
 /**@}*/
@@ -19,6 +19,7 @@
  *============================================================================*/
 
 #include <nanvix/kernel/hal/arch.h>
+#include <nanvix/kernel/hal/core.h>
 #include <nanvix/kernel/hal/cpu.h>
 #include <nanvix/kernel/hal/exception.h>
 #include <nanvix/kernel/hal/interrupt.h>
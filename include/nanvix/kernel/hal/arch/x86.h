@@ -9,12 +9,15 @@
 #include <arch/x86.h>
 #include <nanvix/kernel/hal/arch/x86/ctx.h>
 #include <nanvix/kernel/hal/arch/x86/excp.h>
+#include <nanvix/kernel/hal/arch/x86/fpu.h>
 #include <nanvix/kernel/hal/arch/x86/gdt.h>
 #include <nanvix/kernel/hal/arch/x86/idt.h>
+#include <nanvix/kernel/hal/arch/x86/lapic.h>
 #include <nanvix/kernel/hal/arch/x86/lpic.h>
 #include <nanvix/kernel/hal/arch/x86/memory.h>
 #include <nanvix/kernel/hal/arch/x86/mmu.h>
 #include <nanvix/kernel/hal/arch/x86/spinlock.h>
+#include <nanvix/kernel/hal/arch/x86/sysenter.h>
 #include <nanvix/kernel/hal/arch/x86/trap.h>
 #include <nanvix/kernel/hal/arch/x86/tss.h>
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_HAL_ARCH_X86_FPU_H_
+#define NANVIX_KERNEL_HAL_ARCH_X86_FPU_H_
+
+/**
+ * @addtogroup x86-cpu-fpu x86 FPU
+ * @ingroup x86
+ *
+ * @brief x87 FPU and SSE State
+ *
+ * The x87 FPU and SSE state is switched lazily. On a context switch, the
+ * kernel only sets CR0.TS, so that the next floating-point or SIMD instruction
+ * raises a "coprocessor not available" exception. The state is saved and
+ * restored in the handler of that exception, thus threads that do not use the
+ * FPU never pay for it.
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <arch/x86.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Size of FPU state (in bytes).
+ */
+#define FPU_STATE_SIZE 512
+
+/**
+ * @brief Alignment of FPU state (in bytes).
+ */
+#define FPU_STATE_ALIGN 16
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief FPU state, in the layout of FXSAVE.
+ */
+struct fpu_state {
+    byte_t data[FPU_STATE_SIZE]; /** FXSAVE area. */
+} __attribute__((aligned(FPU_STATE_ALIGN)));
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Initializes the FPU.
+ *
+ * @returns Upon successful completion, zero is returned. If the processor
+ * does not support FXSAVE/FXRSTOR, a negative number is returned instead, and
+ * FPU state is not preserved across context switches.
+ */
+extern int fpu_init(void);
+
+/**
+ * @brief Initializes the FPU of an application core.
+ */
+extern void fpu_core_init(void);
+
+/**
+ * @brief Initializes an FPU state.
+ *
+ * @param state Target FPU state.
+ */
+extern void fpu_state_init(struct fpu_state *state);
+
+/**
+ * @brief Switches to another FPU state.
+ *
+ * @param state FPU state of the execution context that is about to run.
+ */
+extern void fpu_switch(struct fpu_state *state);
+
+/**
+ * @brief Releases an FPU state.
+ *
+ * @param state Target FPU state.
+ */
+extern void fpu_release(struct fpu_state *state);
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_HAL_ARCH_X86_FPU_H_ */
@@ -23,6 +23,24 @@
  */
 extern void gdt_init(void);
 
+/**
+ * @brief Loads the Global Descriptor Table (GDT) in the underlying core.
+ *
+ * @param coreid ID of the underlying core.
+ *
+ * @note The GDT should have been initialized by gdt_init() before.
+ */
+extern void gdt_core_init(unsigned coreid);
+
+/**
+ * @brief Gets the ID of the core that a TSS selector refers to.
+ *
+ * @param tss_selector Target TSS selector.
+ *
+ * @returns The ID of the core that @p tss_selector refers to.
+ */
+extern unsigned gdt_tss_coreid(unsigned tss_selector);
+
 /**
  * @brief Gets the segment selector for the kernel code segment.
  *
@@ -44,6 +62,20 @@ extern unsigned gdt_user_cs(void);
  */
 extern unsigned gdt_user_ds(void);
 
+/**
+ * @brief Gets the segment selector for the user TLS segment.
+ *
+ * @return The segment selector for the user TLS segment.
+ */
+extern unsigned gdt_user_gs(void);
+
+/**
+ * @brief Switches the TLS segment of the underlying core.
+ *
+ * @param base Base address of the TLS segment.
+ */
+extern void gdt_tls_switch(word_t base);
+
 #endif /* !_ASM_FILE_ */
 
 /*============================================================================*/
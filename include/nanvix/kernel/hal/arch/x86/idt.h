@@ -21,6 +21,16 @@
  */
 #define TRAP_GATE 0x80
 
+/**
+ * @brief Inter-processor interrupt gate.
+ */
+#define IPI_GATE 0x30
+
+/**
+ * @brief Spurious interrupt gate of the Local APIC.
+ */
+#define SPURIOUS_GATE 0xff
+
 /*============================================================================*
  * Functions                                                                  *
  *============================================================================*/
@@ -36,6 +46,13 @@
  */
 extern unsigned idt_init(unsigned cs_sel);
 
+/**
+ * @brief Loads the Interrupt Descriptor Table (IDT) in the underlying core.
+ *
+ * @note The IDT should have been initialized by idt_init() before.
+ */
+extern void idt_core_init(void);
+
 #endif /* !_ASM_FILE_ */
 
 /*============================================================================*/
@@ -0,0 +1,93 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_HAL_ARCH_X86_LAPIC_H_
+#define NANVIX_KERNEL_HAL_ARCH_X86_LAPIC_H_
+
+/**
+ * @addtogroup x86-cpu-lapic x86 Local APIC
+ * @ingroup x86
+ *
+ * @brief x86 Local APIC
+ *
+ * Each core has a Local APIC, which the kernel uses to start application cores
+ * and to send inter-processor interrupts. Hardware interrupts are still handled
+ * by the legacy PIC, which is wired to the master core only.
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <arch/x86.h>
+
+#ifndef _ASM_FILE_
+#include <stdbool.h>
+#include <stdint.h>
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Physical address where application cores start executing.
+ *
+ * @note This should be aligned at a page boundary and lie in the first
+ * megabyte of memory.
+ */
+#define LAPIC_STARTUP_BASE 0x8000
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief Initializes the Local APIC of the underlying core.
+ *
+ * @param master Is the underlying core the master core?
+ *
+ * @returns Upon successful completion, zero is returned. If the processor
+ * does not have a Local APIC, a negative number is returned instead.
+ */
+extern int lapic_init(bool master);
+
+/**
+ * @brief Gets the ID of the Local APIC of the underlying core.
+ *
+ * @returns The ID of the Local APIC of the underlying core.
+ */
+extern unsigned lapic_id(void);
+
+/**
+ * @brief Signals the end of an interrupt to the Local APIC.
+ */
+extern void lapic_eoi(void);
+
+/**
+ * @brief Sends an inter-processor interrupt to all other cores.
+ *
+ * @param vector Target interrupt vector.
+ */
+extern void lapic_ipi_broadcast(unsigned vector);
+
+/**
+ * @brief Starts all other cores.
+ *
+ * @param entry Physical address of the real-mode entry point. It should be
+ * aligned at a page boundary and lie in the first megabyte of memory.
+ */
+extern void lapic_startup_broadcast(paddr_t entry);
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_HAL_ARCH_X86_LAPIC_H_ */
@@ -110,6 +110,13 @@ extern void lpic_enable(void);
  */
 extern void lpic_disable(void);
 
+/**
+ * @brief Enables hardware interrupts and halts until one is delivered.
+ *
+ * @note Hardware interrupts are disabled again upon return.
+ */
+extern void lpic_idle(void);
+
 #endif /* !_ASM_FILE */
 
 /*============================================================================*/
@@ -14,6 +14,14 @@
 #define MEMORY_END_PHYS 0x08000000 /** DRAM End  */
 /**@}*/
 
+/**
+ * @name Memory-Mapped I/O Layout
+ */
+/**@{*/
+#define MMIO_BASE_PHYS 0xfee00000 /** Local APIC Base */
+#define MMIO_END_PHYS 0xfee01000  /** Local APIC End  */
+/**@}*/
+
 /**
  * @brief DRAM brief (in bytes).
  */
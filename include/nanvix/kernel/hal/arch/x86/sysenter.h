@@ -0,0 +1,38 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_HAL_ARCH_X86_SYSENTER_H_
+#define NANVIX_KERNEL_HAL_ARCH_X86_SYSENTER_H_
+
+/**
+ * @addtogroup x86-cpu-sysenter x86 SYSENTER
+ * @ingroup x86
+ */
+/**@{*/
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief Initializes the fast kernel call entry point (SYSENTER/SYSEXIT).
+ *
+ * @param kernel_cs GDT selector for the kernel code segment.
+ *
+ * @returns Upon successful completion, zero is returned. If the processor
+ * does not support SYSENTER/SYSEXIT, a negative number is returned instead,
+ * and kernel calls may be issued through the trap gate only.
+ */
+extern int sysenter_init(unsigned kernel_cs);
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_HAL_ARCH_X86_SYSENTER_H_ */
@@ -28,14 +28,28 @@
 extern void tss_load(unsigned tss_selector);
 
 /**
- * @brief Initializes the Task State Segment (TSS).
+ * @brief Initializes the Task State Segments (TSS).
  *
  * @param ss0 GDT selector for ring 0 data segment.
  *
- * @return Returns a pointer to the TSS.
+ * @return Returns a pointer to the array of TSSs, one for each core.
  */
 extern const struct tss *tss_init(unsigned ss0);
 
+/**
+ * @brief Gets the Task State Segment (TSS) of the underlying core.
+ *
+ * @return Returns a pointer to the TSS of the underlying core.
+ */
+extern struct tss *tss_get(void);
+
+/**
+ * @brief Sets the ring 0 stack pointer of the underlying core.
+ *
+ * @param esp0 Ring 0 stack pointer.
+ */
+extern void tss_set_esp0(word_t esp0);
+
 #endif /* !_ASM_FILE_ */
 
 /*============================================================================*/
@@ -0,0 +1,115 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_HAL_CORE_H_
+#define NANVIX_KERNEL_HAL_CORE_H_
+
+/**
+ * @addtogroup hal-core HAL Cores
+ * @ingroup hal
+ *
+ * @brief HAL Cores
+ *
+ * The master core boots the kernel and starts the other cores, which are
+ * called application cores. All cores run kernel code under a single kernel
+ * lock, which a core takes when it enters the kernel and releases when it
+ * leaves the kernel or idles. The kernel lock is recursive, and it is handed
+ * over from one thread to another on context switches.
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/config.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief ID of the master core.
+ */
+#define CORE_MASTER 0
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+#ifndef _ASM_FILE_
+
+/**
+ * @brief Gets the ID of the underlying core.
+ *
+ * @returns The ID of the underlying core.
+ */
+extern unsigned core_get_id(void);
+
+/**
+ * @brief Gets the number of cores that are online.
+ *
+ * @returns The number of cores that are online.
+ */
+extern unsigned cores_online(void);
+
+/**
+ * @brief Starts application cores.
+ *
+ * @details Application cores are started at most once, and at most
+ * KERNEL_CORES_MAX cores are brought online. This should be called by the
+ * master core after paging is enabled.
+ */
+extern void cores_start(void);
+
+/**
+ * @brief Interrupts all other cores that are online.
+ *
+ * @details Interrupted cores run the timer interrupt handler.
+ */
+extern void cores_kick(void);
+
+/**
+ * @brief Acquires the kernel lock.
+ *
+ * @details The kernel lock is recursive: a core that already holds it only
+ * goes one level deeper.
+ */
+extern void klock_acquire(void);
+
+/**
+ * @brief Releases one level of the kernel lock.
+ */
+extern void klock_release(void);
+
+/**
+ * @brief Gets the depth of the kernel lock held by the underlying core.
+ *
+ * @returns The depth of the kernel lock held by the underlying core.
+ */
+extern unsigned klock_save(void);
+
+/**
+ * @brief Sets the depth of the kernel lock held by the underlying core.
+ *
+ * @param depth Target depth. If zero, the kernel lock is released.
+ *
+ * @note The underlying core should hold the kernel lock.
+ */
+extern void klock_restore(unsigned depth);
+
+/**
+ * @brief Releases the kernel lock for a moment, so that other cores may take
+ * it, and acquires it back at the same depth.
+ */
+extern void klock_relax(void);
+
+#endif /* !_ASM_FILE_ */
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_HAL_CORE_H_ */
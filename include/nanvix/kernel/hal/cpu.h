@@ -16,6 +16,23 @@
  */
 extern void cpu_init(void);
 
+/**
+ * @brief Initializes an application core.
+ *
+ * @param coreid ID of the underlying core.
+ */
+extern void cpu_core_init(unsigned coreid);
+
+/**
+ * @brief Reads the cycle counter of the underlying core.
+ *
+ * @returns The number of cycles elapsed since the core was reset.
+ */
+static inline uint64_t cpu_cycles(void)
+{
+    return (tsc_read());
+}
+
 /**
  * @brief Disables interrupts.
  */
@@ -10,6 +10,8 @@
 
 #ifndef _ASM_FILE_
 
+#include <stdbool.h>
+
 /**
  * @brief Dumps context information.
  *
@@ -21,7 +23,8 @@ extern void context_dump(const struct context *ctx);
  * @brief Initializes an execution context.
  *
  * @param ctx   Storage location for the execution context.
- * @param pgdir Page directory.
+ * @param pgdir Page directory. If NULL, the execution context borrows the
+ *              page directory that is loaded when it is switched to.
  * @param kbp   Kernel stack base pointer.
  * @param ksp   Kernel stack pointer.
  *
@@ -31,6 +34,28 @@ extern void context_dump(const struct context *ctx);
 extern int context_create(struct context *ctx, const void *pgdir,
                           const void *kbp, const void *ksp);
 
+/**
+ * @brief Forges a kernel stack that starts running a function.
+ *
+ * @param kernel_stack Kernel stack.
+ * @param kernel_func  Function to run. It should not return.
+ *
+ * @returns Upon successful completion, the kernel stack pointer that starts
+ * running @p kernel_func on the next context switch is returned. Upon failure,
+ * NULL is returned instead.
+ */
+extern void *context_forge_stack(void *kernel_stack, void (*kernel_func)(void));
+
+/**
+ * @brief Checks if switching to an execution context loads a page directory.
+ *
+ * @param to Target execution context.
+ *
+ * @returns If switching to @p to from the underlying core loads another page
+ * directory, true is returned. Otherwise, false is returned instead.
+ */
+extern bool context_switches_pgdir(const struct context *to);
+
 /**
  * @brief Switches execution context.
  *
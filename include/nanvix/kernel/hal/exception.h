@@ -109,6 +109,16 @@ extern int exception_unregister(int excpnum);
  */
 extern int exception_get_num(const struct exception *excp);
 
+/**
+ * @brief Gets the faulting address of an exception.
+ *
+ * @param excp Target exception information structure.
+ *
+ * @returns The faulting address stored in the exception information structure
+ * pointed to by @p excp.
+ */
+extern vaddr_t exception_get_addr(const struct exception *excp);
+
 /**
  * @brief Initializes the exception module.
  */
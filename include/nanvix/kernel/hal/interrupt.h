@@ -19,6 +19,9 @@
  *============================================================================*/
 
 #include <nanvix/kernel/hal/arch.h>
+#ifndef _ASM_FILE_
+#include <stdint.h>
+#endif /* !_ASM_FILE_ */
 
 /*============================================================================*
  * Constants                                                                  *
@@ -59,6 +62,11 @@ typedef void (*interrupt_handler_t)(void);
  */
 extern void do_interrupt(int intnum);
 
+/**
+ * @brief High-level inter-processor interrupt dispatcher.
+ */
+extern void do_ipi(void);
+
 /**
  * @brief Registers an interrupt handler.
  *
@@ -95,6 +103,22 @@ extern void interrupts_enable(void);
  */
 extern void interrupts_init(void);
 
+/**
+ * @brief Gets the number of timer interrupts.
+ *
+ * @returns The number of timer interrupts since system startup.
+ */
+extern uint64_t interrupts_get_ticks(void);
+
+/**
+ * @brief Idles the underlying core until an interrupt is delivered.
+ *
+ * @param ticks Maximum number of timer ticks to idle.
+ *
+ * @note This function should be called with interrupts disabled.
+ */
+extern void interrupts_idle(unsigned ticks);
+
 /**
  * @brief Forges an interrupt stack.
  *
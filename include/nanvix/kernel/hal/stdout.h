@@ -15,6 +15,13 @@
  */
 extern void stdout_init(void);
 
+/**
+ * @brief Enables asynchronous writes to the standard output device.
+ *
+ * @note This should be called after interrupts are initialized.
+ */
+extern void stdout_async_init(void);
+
 /**
  * @brief Writes to the standard output device.
  *
@@ -23,6 +30,21 @@ extern void stdout_init(void);
  */
 extern void stdout_write(const char *buf, size_t n);
 
+/**
+ * @brief Writes to the standard output device asynchronously.
+ *
+ * @param buf Target buffer.
+ * @param n   Number of bytes to write.
+ *
+ * @returns The number of bytes written.
+ */
+extern size_t stdout_write_async(const char *buf, size_t n);
+
+/**
+ * @brief Flushes pending asynchronous writes to the standard output device.
+ */
+extern void stdout_flush(void);
+
 #endif /* !_ASM_FILE_ */
 
 #endif /* NANVIX_KERNEL_HAL_STDOUT_H_ */
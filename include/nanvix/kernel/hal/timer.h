@@ -27,6 +27,29 @@
  */
 extern void timer_init(unsigned freq);
 
+/**
+ * @brief Switches the timer device to periodic mode.
+ */
+extern void timer_periodic(void);
+
+/**
+ * @brief Switches the timer device to one-shot mode.
+ *
+ * @param ticks Number of timer ticks until the timer device fires.
+ *
+ * @returns The number of timer ticks for which the timer device was actually
+ * armed, which may be fewer than @p ticks.
+ */
+extern unsigned timer_oneshot(unsigned ticks);
+
+/**
+ * @brief Gets the number of timer ticks elapsed in one-shot mode.
+ *
+ * @returns The number of whole timer ticks elapsed since the timer device was
+ * last armed in one-shot mode.
+ */
+extern unsigned timer_elapsed(void);
+
 #endif /* _ASM_FILE_ */
 
 /*============================================================================*/
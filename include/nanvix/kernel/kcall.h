@@ -6,6 +6,16 @@
 #ifndef NANVIX_KERNEL_KCALL_H_
 #define NANVIX_KERNEL_KCALL_H_
 
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <stdint.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
 /**
  * @brief Number of system calls.
  *
@@ -31,59 +41,140 @@
  * @name System Call Numbers
  */
 /**@{*/
-#define NR_void0 0          /** kernel_void0()            */
-#define NR_void1 1          /** kernel_void1()            */
-#define NR_void2 2          /** kernel_void2()            */
-#define NR_void3 3          /** kernel_void3()            */
-#define NR_void4 4          /** kernel_void4()            */
-#define NR_void5 5          /** kernel_void5()            */
-#define NR_shutdown 6       /** kernel_shutdown()         */
-#define NR_write 7          /** kernel_write()            */
-#define NR_fralloc 8        /** kernel_fralloc()          */
-#define NR_frfree 9         /** kernel_frfree()           */
-#define NR_vmcreate 10      /** kernel_vmcreate()         */
-#define NR_vmremove 11      /** kernel_vmremove()         */
-#define NR_vmmap 12         /** kernel_vmmap()            */
-#define NR_vmunmap 13       /** kernel_vmunmap()          */
-#define NR_vmctrl 14        /** kernel_vmctrl()           */
-#define NR_vminfo 15        /** kernel_vminfo()           */
-#define NR_kmod_get 16      /** kernel_kmod_get()         */
-#define NR_spawn 17         /** kernel_spawn()            */
-#define NR_semget 18        /** kernel_semget()           */
-#define NR_semop 19         /** kernel_semop()            */
-#define NR_semctl 20        /** kernel_semctl()           */
-#define NR_thread_get_id 21 /** kernel_thread_get_id()    */
-#define NR_thread_create 22 /** kernel_thread_create()    */
-#define NR_thread_exit 23   /** kernel_thread_exit()      */
-#define NR_thread_yield 24  /** kernel_thread_yield()     */
-#define NR_mailbox_tag 25   /** kernel_mailbox_tag        */
-#define NR_thread_join 26   /** kernel_thread_join()      */
-#define NR_thread_detach 27 /** kernel_thread_detach()    */
-#define NR_last_kcall 28    /** NR_SYSCALLS definer       */
-#define NR__exit            /** kernel_exit()             */
-#define NR_process_get_id   /** kernel_process_get_id()   */
-#define NR_process_create   /** kernel_process_create()   */
-#define NR_process_exit     /** kernel_process_exit()     */
-#define NR_process_join     /** kernel_process_join()     */
-#define NR_process_yield    /** kernel_process_yield()    */
-#define NR_sleep            /** kernel_sleep()            */
-#define NR_wakeup           /** kernel_wakeup()           */
-#define NR_sigctl           /** kernel_sigctl()           */
-#define NR_alarm            /** kernel_alarm()            */
-#define NR_sigsend          /** kernel_sigsend()          */
-#define NR_sigwait          /** kernel_sigwait()          */
-#define NR_sigreturn        /** kernel_sigreturn()        */
-#define NR_clock            /** kernel_clock()            */
-#define NR_stats            /** kernel_stats()            */
-#define NR_upage_alloc      /** kernel_upage_alloc()      */
-#define NR_upage_free       /** kernel_upage_free()       */
-#define NR_upage_map        /** kernel_upage_map()        */
-#define NR_upage_link       /** kernel_upage_link()       */
-#define NR_upage_unlink     /** kernel_upage_unlink()     */
-#define NR_upage_unmap      /** kernel_upage_unmap()      */
-#define NR_excp_ctrl        /** kernel_excp_ctrl()        */
-#define NR_excp_pause       /** kernel_excp_pause()       */
-#define NR_excp_resume      /** kernel_excp_resume()      */
+#define NR_void0 0                /** kernel_void0()               */
+#define NR_void1 1                /** kernel_void1()               */
+#define NR_void2 2                /** kernel_void2()               */
+#define NR_void3 3                /** kernel_void3()               */
+#define NR_void4 4                /** kernel_void4()               */
+#define NR_void5 5                /** kernel_void5()               */
+#define NR_shutdown 6             /** kernel_shutdown()            */
+#define NR_write 7                /** kernel_write()               */
+#define NR_fralloc 8              /** kernel_fralloc()             */
+#define NR_frfree 9               /** kernel_frfree()              */
+#define NR_vmcreate 10            /** kernel_vmcreate()            */
+#define NR_vmremove 11            /** kernel_vmremove()            */
+#define NR_vmmap 12               /** kernel_vmmap()               */
+#define NR_vmunmap 13             /** kernel_vmunmap()             */
+#define NR_vmctrl 14              /** kernel_vmctrl()              */
+#define NR_vminfo 15              /** kernel_vminfo()              */
+#define NR_kmod_get 16            /** kernel_kmod_get()            */
+#define NR_spawn 17               /** kernel_spawn()               */
+#define NR_semget 18              /** kernel_semget()              */
+#define NR_semop 19               /** kernel_semop()               */
+#define NR_semctl 20              /** kernel_semctl()              */
+#define NR_thread_get_id 21       /** kernel_thread_get_id()       */
+#define NR_thread_create 22       /** kernel_thread_create()       */
+#define NR_thread_exit 23         /** kernel_thread_exit()         */
+#define NR_thread_yield 24        /** kernel_thread_yield()        */
+#define NR_mailbox_tag 25         /** kernel_mailbox_tag           */
+#define NR_thread_join 26         /** kernel_thread_join()         */
+#define NR_thread_detach 27       /** kernel_thread_detach()       */
+#define NR_kcall_submit 28        /** kernel_kcall_submit()        */
+#define NR_stats 29               /** kernel_stats()               */
+#define NR_thread_setprio 30      /** kernel_thread_setprio()      */
+#define NR_thread_getprio 31      /** kernel_thread_getprio()      */
+#define NR_thread_setquantum 32   /** kernel_thread_setquantum()   */
+#define NR_thread_getquantum 33   /** kernel_thread_getquantum()   */
+#define NR_thread_yield_to 34     /** kernel_thread_yield_to()     */
+#define NR_thread_stats 35        /** kernel_thread_stats()        */
+#define NR_process_stats 36       /** kernel_process_stats()       */
+#define NR_sleep 37               /** kernel_sleep()               */
+#define NR_thread_join_timeout 38 /** kernel_thread_join_timeout() */
+#define NR_thread_setrt 39        /** kernel_thread_setrt()        */
+#define NR_thread_getrt 40        /** kernel_thread_getrt()        */
+#define NR_sched_affinity 41      /** kernel_sched_affinity()      */
+#define NR_thread_settls 42       /** kernel_thread_settls()       */
+#define NR_process_setshare 43    /** kernel_process_setshare()    */
+#define NR_process_getshare 44    /** kernel_process_getshare()    */
+#define NR_process_get_id 45      /** kernel_process_get_id()      */
+#define NR_last_kcall 46          /** NR_SYSCALLS definer          */
+#define NR__exit                  /** kernel_exit()                */
+#define NR_process_create         /** kernel_process_create()      */
+#define NR_process_exit           /** kernel_process_exit()        */
+#define NR_process_join           /** kernel_process_join()        */
+#define NR_process_yield          /** kernel_process_yield()       */
+#define NR_wakeup                 /** kernel_wakeup()              */
+#define NR_sigctl                 /** kernel_sigctl()              */
+#define NR_alarm                  /** kernel_alarm()               */
+#define NR_sigsend                /** kernel_sigsend()             */
+#define NR_sigwait                /** kernel_sigwait()             */
+#define NR_sigreturn              /** kernel_sigreturn()           */
+#define NR_clock                  /** kernel_clock()               */
+#define NR_upage_alloc            /** kernel_upage_alloc()         */
+#define NR_upage_free             /** kernel_upage_free()          */
+#define NR_upage_map              /** kernel_upage_map()           */
+#define NR_upage_link             /** kernel_upage_link()          */
+#define NR_upage_unlink           /** kernel_upage_unlink()        */
+#define NR_upage_unmap            /** kernel_upage_unmap()         */
+#define NR_excp_ctrl              /** kernel_excp_ctrl()           */
+#define NR_excp_pause             /** kernel_excp_pause()          */
+#define NR_excp_resume            /** kernel_excp_resume()         */
 /**@}*/
 
+/**
+ * @brief Number of entries in a kernel call ring.
+ *
+ * @note This should be a power of two.
+ */
+#define KCALL_RING_LENGTH 64
+
+/**
+ * @brief Number of buckets in a kernel call latency histogram.
+ */
+#define KCALL_STATS_BUCKETS 32
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Kernel call submission entry.
+ */
+struct kcall_sqe {
+    uint32_t kcall_nr; /** Kernel call number.           */
+    uint32_t args[5];  /** Kernel call arguments.        */
+    uint32_t tag;      /** Tag echoed in the completion. */
+};
+
+/**
+ * @brief Kernel call completion entry.
+ */
+struct kcall_cqe {
+    uint32_t tag; /** Tag of the submission entry. */
+    int32_t ret;  /** Return value.                */
+};
+
+/**
+ * @brief Kernel call ring.
+ *
+ * @details A kernel call ring lives in user memory and it is shared between a
+ * process and the kernel. The process queues submission entries and advances
+ * @p sq_tail, then it traps once with kernel_kcall_submit(). The kernel
+ * consumes submission entries by advancing @p sq_head, and it posts the
+ * outcome of each kernel call in the completion queue by advancing
+ * @p cq_tail. The process consumes completions by advancing @p cq_head.
+ * Indexes run freely and they are wrapped around with KCALL_RING_LENGTH.
+ */
+struct kcall_ring {
+    uint32_t sq_head;                       /** Submission queue head.  */
+    uint32_t sq_tail;                       /** Submission queue tail.  */
+    uint32_t cq_head;                       /** Completion queue head.  */
+    uint32_t cq_tail;                       /** Completion queue tail.  */
+    struct kcall_sqe sq[KCALL_RING_LENGTH]; /** Submission queue.       */
+    struct kcall_cqe cq[KCALL_RING_LENGTH]; /** Completion queue.       */
+};
+
+/**
+ * @brief Kernel call statistics.
+ *
+ * @details Bucket @p i of the latency histogram counts kernel calls that took
+ * [2^i, 2^(i+1)) cycles to complete. The last bucket also counts kernel calls
+ * that took longer than that.
+ */
+struct kcall_stats {
+    uint32_t count;                        /** Number of invocations. */
+    uint32_t errors;                       /** Number of failures.    */
+    uint32_t latency[KCALL_STATS_BUCKETS]; /** Latency histogram.     */
+};
+
 #endif /* NANVIX_KERNEL_KCALL_H_ */
@@ -11,6 +11,8 @@
  *============================================================================*/
 
 #include <nanvix/kernel/mm/frame.h>
+#include <nanvix/kernel/mm/kcache.h>
+#include <nanvix/kernel/mm/kinfo.h>
 #include <nanvix/kernel/mm/kpool.h>
 #include <nanvix/kernel/mm/memory.h>
 #include <nanvix/kernel/mm/upool.h>
@@ -66,6 +66,13 @@ extern int frame_alloc(frame_t frame);
  */
 extern int frame_free(frame_t frame);
 
+/**
+ * @brief Counts free page frames.
+ *
+ * @returns The number of page frames for user use that are free.
+ */
+extern unsigned frame_count_free(void);
+
 /**
  * @brief Initializes the frame allocator.
  */
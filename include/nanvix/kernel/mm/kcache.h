@@ -0,0 +1,95 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_MM_KCACHE_H_
+#define NANVIX_KERNEL_MM_KCACHE_H_
+
+/**
+ * @addtogroup kernel-mm-kcache Kernel Object Cache
+ * @ingroup kernel-mm
+ *
+ * @brief Kernel Object Cache
+ *
+ * A Kernel Object Cache hands out fixed-size kernel objects, such as control
+ * blocks, on demand. Objects are carved out of slabs, which are kernel pages
+ * taken from the Kernel Page Pool. Slabs are taken when the cache runs out of
+ * free objects, and they are given back once all their objects are released.
+ * Both allocating and releasing an object take constant time.
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/mm/kpool.h>
+#include <stddef.h>
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Slab of a kernel object cache (opaque).
+ */
+struct kslab;
+
+/**
+ * @brief Kernel object cache.
+ */
+struct kcache {
+    const char *name;      /** Name.                          */
+    size_t size;           /** Size of objects (in bytes).    */
+    size_t offset;         /** Offset of first object.        */
+    unsigned capacity;     /** Number of objects per slab.    */
+    unsigned nslabs;       /** Number of slabs.               */
+    unsigned nobjects;     /** Number of objects in use.      */
+    struct kslab *partial; /** Slabs that have free objects.  */
+};
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Initializes a kernel object cache.
+ *
+ * @param cache Target kernel object cache.
+ * @param name  Name of the kernel object cache.
+ * @param size  Size of objects (in bytes).
+ * @param align Alignment of objects (in bytes). This should be a power of two.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcache_init(struct kcache *cache, const char *name, size_t size,
+                       size_t align);
+
+/**
+ * @brief Allocates an object from a kernel object cache.
+ *
+ * @param cache Target kernel object cache.
+ *
+ * @returns Upon successful completion, a pointer to a zeroed object is
+ * returned. Upon failure, NULL is returned instead.
+ */
+extern void *kcache_alloc(struct kcache *cache);
+
+/**
+ * @brief Releases an object to a kernel object cache.
+ *
+ * @param cache Target kernel object cache.
+ * @param obj   Target object.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcache_free(struct kcache *cache, void *obj);
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_MM_KCACHE_H_ */
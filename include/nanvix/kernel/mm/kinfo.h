@@ -0,0 +1,123 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_MM_KINFO_H_
+#define NANVIX_KERNEL_MM_KINFO_H_
+
+/**
+ * @addtogroup kernel-mm-kinfo Kernel Information Page
+ * @ingroup kernel-mm
+ *
+ * @brief Kernel Information Page
+ *
+ * The Kernel Information Page is a kernel page that is mapped read-only in
+ * every user virtual memory space. The kernel keeps it up to date on context
+ * switches and on timer ticks, so that user code may query frequently-used
+ * kernel information with plain loads, instead of issuing kernel calls.
+ */
+/**@{*/
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/mm/memory.h>
+#include <nanvix/types.h>
+#include <stdint.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Virtual address of the kernel information page.
+ *
+ * @note This lies right below the area of user stacks.
+ */
+#define KINFO_BASE_VIRT (USER_STACK_LIMIT - PAGE_SIZE)
+
+/**
+ * @brief Size of kernel information.
+ */
+#define __SIZEOF_KINFO 32
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Kernel information.
+ *
+ * @details The sequence number is odd while the kernel is updating the
+ * remaining fields. Readers should retry if they observe an odd sequence
+ * number, or if it changes while they read the remaining fields. The IDs of
+ * the running thread and process are only meaningful if a single core is
+ * online, because they are shared by all cores.
+ */
+struct kinfo {
+    uint32_t seq;         /** Sequence number.         */
+    tid_t tid;            /** ID of running thread.    */
+    pid_t pid;            /** ID of running process.   */
+    uint32_t free_frames; /** Number of free frames.   */
+    uint64_t ticks;       /** Number of timer ticks.   */
+    uint32_t cores;       /** Number of online cores.  */
+    uint32_t reserved;    /** Reserved.                */
+};
+
+/*============================================================================*
+ * Functions                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Maps the kernel information page in a page directory.
+ *
+ * @param pgdir Target page directory.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative number is returned instead.
+ */
+extern int kinfo_map(struct pde *pgdir);
+
+/**
+ * @brief Unmaps the kernel information page from a page directory.
+ *
+ * @param pgdir Target page directory.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative number is returned instead.
+ */
+extern int kinfo_unmap(struct pde *pgdir);
+
+/**
+ * @brief Updates the kernel information page on a context switch.
+ *
+ * @param tid ID of the thread that is about to run.
+ * @param pid ID of the process that owns the thread that is about to run.
+ */
+extern void kinfo_switch(tid_t tid, pid_t pid);
+
+/**
+ * @brief Updates the kernel information page on a timer tick.
+ */
+extern void kinfo_tick(void);
+
+/**
+ * @brief Updates the kernel information page once cores come online.
+ *
+ * @param ncores Number of cores that are online.
+ */
+extern void kinfo_cores(unsigned ncores);
+
+/**
+ * @brief Initializes the kernel information page.
+ */
+extern void kinfo_init(void);
+
+/*============================================================================*/
+
+/**@}*/
+
+#endif /* NANVIX_KERNEL_MM_KINFO_H_ */
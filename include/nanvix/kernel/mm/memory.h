@@ -44,6 +44,20 @@
 #define USER_END_PHYS MEMORY_END_PHYS                 /** User End        */
 /**@}*/
 
+/**
+ * @name User Stack Area
+ *
+ * @details The user stack area lies at the top of user memory and it is split
+ * in fixed-size regions, one for each thread of a process. Each region holds a
+ * stack that grows downwards on demand, and an unmapped guard page below it.
+ */
+/**@{*/
+#define USER_STACK_REGIONS 16                   /** Number of Regions */
+#define USER_STACK_REGION_SIZE (PAGE_SIZE << 6) /** Region Size       */
+#define USER_STACK_SIZE                                                        \
+    (USER_STACK_REGIONS * USER_STACK_REGION_SIZE) /** Area Size */
+/**@}*/
+
 /**
  * @name Virtual Memory Layout
  */
@@ -55,7 +69,7 @@
 #define USER_BASE_VIRT USER_BASE_PHYS     /** User Base            */
 #define USER_END_VIRT USER_END_PHYS       /** User End             */
 #define USER_STACK_LIMIT                                                       \
-    (USER_END_VIRT - (PAGE_SIZE << 4)) /** User Stack Limit */
+    (USER_END_VIRT - USER_STACK_SIZE) /** User Stack Limit */
 /**@}*/
 
 /**
@@ -15,6 +15,7 @@
 #include <nanvix/kernel/pm/process.h>
 #include <nanvix/kernel/pm/semaphore.h>
 #include <nanvix/kernel/pm/thread.h>
+#include <nanvix/kernel/pm/timeout.h>
 
 /*============================================================================*
  * Public Functions                                                           *
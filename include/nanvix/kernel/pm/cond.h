@@ -10,9 +10,13 @@
 
 /**
  * @brief Condition variable.
+ *
+ * @details Threads that wait on a condition variable are linked in a FIFO
+ * queue, so that they are woken up in the order that they started waiting.
  */
 struct condvar {
-    struct process *queue; /** Sleeping queue. */
+    struct thread *head; /** First waiting thread. */
+    struct thread *tail; /** Last waiting thread.  */
 };
 
 /**
@@ -22,7 +26,7 @@ struct condvar {
  */
 #define COND_INITIALIZER                                                       \
     {                                                                          \
-        .queue = NULL                                                          \
+        .head = NULL, .tail = NULL                                             \
     }
 
 /**
@@ -32,7 +36,8 @@ struct condvar {
  */
 static inline void cond_init(struct condvar *cond)
 {
-    cond->queue = NULL;
+    cond->head = NULL;
+    cond->tail = NULL;
 }
 
 /**
@@ -46,7 +51,39 @@ static inline void cond_init(struct condvar *cond)
 extern int cond_wait(struct condvar *cond);
 
 /**
- * @brief Unlocks all processes waiting on a condition variable.
+ * @brief Waits on a condition variable and yields the CPU to a thread.
+ *
+ * @param cond Target condition variable.
+ * @param tid  ID of the thread to yield the CPU to.
+ *
+ * @returns Upon successful completion zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int cond_wait_to(struct condvar *cond, tid_t tid);
+
+/**
+ * @brief Waits on a condition variable, with a timeout.
+ *
+ * @param cond  Target condition variable.
+ * @param ticks Maximum number of timer ticks to wait, or TIMEOUT_INFINITE.
+ *
+ * @returns Upon successful completion zero is returned. If the timeout
+ * expires first, -ETIMEDOUT is returned instead.
+ */
+extern int cond_wait_timeout(struct condvar *cond, unsigned ticks);
+
+/**
+ * @brief Unlocks the first thread waiting on a condition variable.
+ *
+ * @param cond Target condition variable.
+ *
+ * @returns Upon successful completion zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int cond_signal(struct condvar *cond);
+
+/**
+ * @brief Unlocks all threads waiting on a condition variable.
  *
  * @param cond Target condition variable.
  *
@@ -55,4 +92,11 @@ extern int cond_wait(struct condvar *cond);
  */
 extern int cond_broadcast(struct condvar *cond);
 
+/**
+ * @brief Removes a thread from the condition variable that it waits on.
+ *
+ * @param t Target thread.
+ */
+extern void cond_leave(struct thread *t);
+
 #endif /* NANVIX_KERNEL_PM_COND_H_ */
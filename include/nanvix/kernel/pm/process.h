@@ -21,8 +21,10 @@
 
 /**
  * @brief Maximum number of processes.
+ *
+ * @note This should be a power of two.
  */
-#define PROCESS_MAX 16
+#define PROCESS_MAX 64
 
 /**
  * @brief Kernel process ID.
@@ -9,6 +9,7 @@
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 #include <nanvix/kernel/pm/cond.h>
+#include <nanvix/kernel/pm/timeout.h>
 
 /**
  * @brief Maximum Number of semaphores in the system.
@@ -35,6 +36,8 @@ struct semaphore {
     pid_t proc_owner;             /** Owner process.      */
     pid_t proc_user[PROCESS_MAX]; /** Users process.      */
     unsigned key;                 /** Semphore key.       */
+    tid_t holder;                 /** Last acquirer.      */
+    struct semaphore *next;       /** Next in held list.  */
 };
 
 /**
@@ -48,7 +51,7 @@ struct semaphore {
  */
 #define SEMAPHORE_INITIALIZER(x)                                               \
     {                                                                          \
-        .count = (x), .cond = COND_INITIALIZER,                                \
+        .count = (x), .cond = COND_INITIALIZER, .holder = -1,                  \
     }
 
 /**
@@ -67,6 +70,8 @@ static inline void semaphore_init(struct semaphore *sem, int x)
     KASSERT(sem != NULL);
 
     sem->count = x;
+    sem->holder = -1;
+    sem->next = NULL;
     cond_init(&sem->cond);
 }
 
@@ -120,6 +125,17 @@ extern int semaphore_set(int semid, int count);
  */
 extern void semaphore_down(struct semaphore *sem);
 
+/**
+ * @brief Performs a down operation in a semaphore, with a timeout.
+ *
+ * @param sem   Target semaphore.
+ * @param ticks Maximum number of timer ticks to wait, or TIMEOUT_INFINITE.
+ *
+ * @returns Upon successful completion, zero is returned. If the semaphore is
+ * not acquired in time, -ETIMEDOUT is returned instead.
+ */
+extern int semaphore_down_timeout(struct semaphore *sem, unsigned ticks);
+
 /**
  * @brief Performs an up operation in a semaphore.
  *
@@ -127,4 +143,11 @@ extern void semaphore_down(struct semaphore *sem);
  */
 extern void semaphore_up(struct semaphore *sem);
 
+/**
+ * @brief Drops all semaphores held by a thread.
+ *
+ * @param tid ID of the target thread.
+ */
+extern void semaphore_drop_held(tid_t tid);
+
 #endif /* NANVIX_KERNEL_PM_SEMAPHORE_H_ */
@@ -12,7 +12,11 @@
 
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm/memory.h>
+#include <nanvix/kernel/pm/cond.h>
+#include <nanvix/kernel/pm/timeout.h>
 #include <nanvix/types.h>
+#include <stdnoreturn.h>
 
 /*============================================================================*
  * Constants                                                                  *
@@ -20,8 +24,42 @@
 
 /**
  * @brief Maximum number of threads.
+ *
+ * @note This should be a power of two.
+ */
+#define THREADS_MAX 256
+
+/**
+ * @brief Maximum number of threads in a process.
+ *
+ * @details Each thread of a process has a region in the user stack area.
  */
-#define THREADS_MAX 16
+#define THREAD_USTACK_MAX USER_STACK_REGIONS
+
+/**
+ * @name User Stack Sizes
+ *
+ * @details Stack sizes are rounded up to a multiple of the page size. The
+ * largest stack leaves room for a guard page in its region.
+ */
+/**@{*/
+#define THREAD_STACK_SIZE_MIN PAGE_SIZE            /** Smallest. */
+#define THREAD_STACK_SIZE_DEFAULT (PAGE_SIZE << 4) /** Default.  */
+#define THREAD_STACK_SIZE_MAX                                                  \
+    (USER_STACK_REGION_SIZE - PAGE_SIZE) /** Largest. */
+/**@}*/
+
+/**
+ * @name Stack Cache
+ *
+ * @details Stacks of threads that exit are kept in a cache of their process,
+ * so that threads that are created later reuse them. A cached kernel stack is
+ * not cleaned again, and a cached user stack keeps its first pages mapped.
+ */
+/**@{*/
+#define THREAD_STACK_CACHE_MAX 4   /** Stacks kept per process. */
+#define THREAD_STACK_CACHE_PAGES 4 /** User stack pages kept.   */
+/**@}*/
 
 /**
  * @name Thread States
@@ -35,27 +73,205 @@
 #define THREAD_WAITING 5    /** Waiting     */
 /**@}*/
 
+/**
+ * @name Thread Priorities
+ *
+ * @details Threads with higher priority values are scheduled first. Threads
+ * with the same priority are scheduled in round-robin order.
+ */
+/**@{*/
+#define THREAD_PRIO_LEVELS 4                     /** Number of levels. */
+#define THREAD_PRIO_MIN 0                        /** Lowest.           */
+#define THREAD_PRIO_MAX (THREAD_PRIO_LEVELS - 1) /** Highest.          */
+#define THREAD_PRIO_DEFAULT 1                    /** Default.          */
+/**@}*/
+
+/**
+ * @name Thread Quantum
+ *
+ * @details The quantum of a thread is the length of its time slice, in timer
+ * ticks. Threads with an adaptive quantum get shorter slices when they block
+ * before their slice expires, and longer slices when their slice expires.
+ */
+/**@{*/
+#define THREAD_QUANTUM_ADAPTIVE 0 /** Adaptive.           */
+#define THREAD_QUANTUM_MIN 1      /** Shortest.           */
+#define THREAD_QUANTUM_MAX 100    /** Longest.            */
+#define THREAD_QUANTUM_DEFAULT 10 /** Default.            */
+/**@}*/
+
+/**
+ * @name Real-Time Class
+ *
+ * @details Real-time threads run a budget of timer ticks in every period, and
+ * they are scheduled by earliest deadline first, ahead of all other threads.
+ * The density of a real-time thread is the ratio of its budget to its relative
+ * deadline. A thread is admitted to the real-time class only if the densities
+ * of all real-time threads add up to no more than THREAD_RT_DENSITY_MAX.
+ */
+/**@{*/
+#define THREAD_RT_PERIOD_MAX 1000    /** Longest period (in ticks).  */
+#define THREAD_RT_DENSITY_SCALE 1000 /** Density of a full core.     */
+#define THREAD_RT_DENSITY_MAX 900    /** Admissible density.         */
+/**@}*/
+
+/**
+ * @name Fair Share
+ *
+ * @details Threads in the regular class are scheduled by fair share across
+ * processes. Each process accrues virtual runtime while its threads run, at a
+ * rate inversely proportional to its weight, and among ready threads with the
+ * same priority, those of the process with the least virtual runtime run
+ * first. A process may also be capped to a quota of timer ticks in every
+ * period, after which its threads are throttled until the next period.
+ */
+/**@{*/
+#define THREAD_SHARE_WEIGHT_MIN 1       /** Lowest weight.              */
+#define THREAD_SHARE_WEIGHT_MAX 10000   /** Highest weight.             */
+#define THREAD_SHARE_WEIGHT_DEFAULT 100 /** Default weight.             */
+#define THREAD_SHARE_PERIOD_MAX 1000    /** Longest period (in ticks).  */
+/**@}*/
+
+/**
+ * @name Address Space Affinity
+ *
+ * @details Under address space affinity, a ready thread of the process whose
+ * address space is loaded on a core runs ahead of older threads with the same
+ * priority, so that fewer switches load another address space. The bound of
+ * address space affinity is the number of times in a row that the oldest ready
+ * thread may be passed over. A zero bound turns address space affinity off.
+ */
+/**@{*/
+#define THREAD_AFFINITY_DEFAULT 0 /** Default bound.            */
+#define THREAD_AFFINITY_MAX 16    /** Largest bound.            */
+/**@}*/
+
+/**
+ * @brief Size of thread quantum information.
+ */
+#define __SIZEOF_THREAD_QUANTUM 16
+
+/**
+ * @brief Size of thread statistics.
+ */
+#define __SIZEOF_THREAD_STATS 56
+
+/**
+ * @brief Size of real-time parameters.
+ */
+#define __SIZEOF_THREAD_RT 12
+
+/**
+ * @brief Size of fair share parameters.
+ */
+#define __SIZEOF_THREAD_SHARE 12
+
 /*============================================================================*
  * Structures                                                                 *
  *============================================================================*/
 
+/**
+ * @brief Thread statistics.
+ *
+ * @details Times are measured in processor cycles. Time spent handling
+ * interrupts and exceptions is charged to user time, and threads of the kernel
+ * process only accumulate kernel time, or idle time for idle threads. Switches
+ * to a thread are split by whether they load another address space.
+ */
+struct thread_stats {
+    uint64_t user_cycles;   /** Time in user mode.            */
+    uint64_t kernel_cycles; /** Time in kernel calls.         */
+    uint64_t ready_cycles;  /** Time ready, but not running.  */
+    uint64_t idle_cycles;   /** Time idling.                  */
+    uint32_t nvcsw;         /** Voluntary context switches.   */
+    uint32_t nivcsw;        /** Involuntary context switches. */
+    uint32_t misses;        /** Deadlines missed.             */
+    uint32_t throttles;     /** Budgets overrun.              */
+    uint32_t as_same;       /** Switches in, same space.      */
+    uint32_t as_cross;      /** Switches in, other space.     */
+};
+
+/**
+ * @brief Real-time parameters of a thread.
+ *
+ * @details Times are measured in timer ticks. A thread with a zero period is
+ * not a real-time thread.
+ */
+struct thread_rt {
+    uint32_t period;   /** Period.                        */
+    uint32_t budget;   /** Budget in each period.         */
+    uint32_t deadline; /** Deadline, relative to period.  */
+};
+
+/**
+ * @brief Fair share parameters of a process.
+ *
+ * @details A process with a zero quota is not capped, and its period is
+ * ignored.
+ */
+struct thread_share {
+    uint32_t weight; /** Weight.                        */
+    uint32_t quota;  /** Ticks in each period.          */
+    uint32_t period; /** Period (in ticks).             */
+};
+
 /**
  * @brief Thread.
  */
 struct thread {
-    tid_t tid;          /** Thread ID.              */
-    pid_t pid;          /** Process ID.             */
-    unsigned age;       /** Age.                    */
-    short state;        /** State.                  */
-    unsigned quantum;   /** Quantum.                */
-    struct context ctx; /** Execution context.      */
-    byte_t *kstack;     /** Kernel Stack.           */
-    byte_t *ustack;     /** User Stack.             */
-    void *(*start)();   /** Start routine.          */
-    void *args;         /** Arguments.              */
-    void *retval;       /** Return value.           */
-    bool detached;      /** Detached.               */
-    bitmap_t waitmap;   /** Wait bitmap.            */
+    tid_t tid;                 /** Thread ID.             */
+    pid_t pid;                 /** Process ID.            */
+    short state;               /** State.                 */
+    unsigned quantum;          /** Ticks used in slice.   */
+    unsigned slice;            /** Time slice (in ticks). */
+    bool adaptive;             /** Adaptive time slice?   */
+    unsigned slices;           /** Time slices used.      */
+    unsigned expired;          /** Time slices expired.   */
+    int prio;                  /** Effective priority.    */
+    int baseprio;              /** Static priority.       */
+    struct context ctx;        /** Execution context.     */
+    byte_t *kstack;            /** Kernel Stack.          */
+    byte_t *ustack;            /** User stack (top).      */
+    size_t ustack_size;        /** User stack size.       */
+    byte_t *ustack_low;        /** Lowest mapped page.    */
+    void *(*start)();          /** Start routine.         */
+    void *args;                /** Arguments.             */
+    void *retval;              /** Return value.          */
+    bool detached;             /** Detached.              */
+    struct condvar joiners;    /** Joining threads.       */
+    struct thread *prev;       /** Previous ready thread. */
+    struct thread *next;       /** Next ready thread.     */
+    struct condvar *wchan;     /** Waiting channel.       */
+    struct thread *wnext;      /** Next waiting thread.   */
+    struct fpu_state fpu;      /** FPU state.             */
+    word_t tls;                /** TLS base address.      */
+    unsigned core;             /** Core (last) run on.    */
+    bool killed;               /** Released remotely?     */
+    struct thread_stats stats; /** CPU accounting.        */
+    struct semaphore *held;    /** Held semaphores.       */
+    uint64_t stamp;            /** Last accounting event. */
+    uint64_t ready_stamp;      /** Became ready at.       */
+    unsigned kdepth;           /** Kernel call depth.     */
+    struct timeout timeout;    /** Wakeup timeout.        */
+    bool timedout;             /** Woken up by timeout?   */
+    struct thread_rt rt;       /** Real-time parameters.  */
+    uint64_t rt_release;       /** Start of period.       */
+    uint64_t rt_deadline;      /** Absolute deadline.     */
+    unsigned rt_used;          /** Budget used.           */
+    bool rt_throttled;         /** Budget overrun?        */
+    bool rt_done;              /** Job done?              */
+    bool rt_checked;           /** Deadline checked?      */
+    struct timeout rt_timer;   /** Period timer.          */
+};
+
+/**
+ * @brief Thread quantum information.
+ */
+struct thread_quantum {
+    uint32_t quantum;        /** Time slice (in ticks).    */
+    uint32_t adaptive;       /** Adaptive time slice?      */
+    uint32_t slices_used;    /** Time slices used.         */
+    uint32_t slices_expired; /** Time slices expired.      */
 };
 
 /*============================================================================*
@@ -74,6 +290,8 @@ extern void thread_init(void);
  * @param start Start routine.
  * @param args Arguments.
  * @param caller Thread caller function.
+ * @param stacksize Size of the user stack (in bytes). If zero, the default
+ * size is used.
  *
  * @note This function has two different behaviors. If called from
  * `process_create()`, it creates the root process thread, thus parameters
@@ -84,7 +302,20 @@ extern void thread_init(void);
  * returned. Upon failure, a negative error code is returned instead.
  */
 extern tid_t thread_create(struct process *p, void *(*start)(), void *args,
-                           void (*caller)(void));
+                           void (*caller)(void), size_t stacksize);
+
+/**
+ * @brief Creates a new kernel thread.
+ *
+ * @param func Routine that the new thread runs. It should not return.
+ *
+ * @details The new thread belongs to the kernel process and it runs with the
+ * kernel lock held. It has no address space of its own.
+ *
+ * @returns Upon successful completion, the ID of the created thread is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern tid_t thread_create_kernel(void (*func)(void));
 
 /**
  * @brief Releases the target thread entry.
@@ -106,6 +337,56 @@ extern int thread_free(tid_t tid);
  */
 extern int thread_free_all(pid_t pid);
 
+/**
+ * @brief Gets statistics of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for thread statistics.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_getstats(tid_t tid, struct thread_stats *buf);
+
+/**
+ * @brief Gets statistics of all threads from a process.
+ *
+ * @details Statistics of threads that were released are included.
+ *
+ * @param pid ID of the target process.
+ * @param buf Storage location for process statistics.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_getstats_all(pid_t pid, struct thread_stats *buf);
+
+/**
+ * @brief Charges time to the calling thread as it enters a kernel call.
+ */
+extern void thread_kcall_enter(void);
+
+/**
+ * @brief Charges time to the calling thread as it leaves a kernel call.
+ */
+extern void thread_kcall_leave(void);
+
+/**
+ * @brief Releases the calling thread if it was released by another core.
+ *
+ * @details A thread that is running on another core cannot be released right
+ * away, thus it is flagged instead, and it is released by the core that runs
+ * it. This function does not return if the calling thread was flagged.
+ */
+extern void thread_check_killed(void);
+
+/**
+ * @brief Runs the scheduler on an application core.
+ *
+ * @note The underlying core should hold the kernel lock.
+ */
+extern noreturn void thread_core_start(void);
+
 /**
  * @brief Gets the execution context of a thread.
  *
@@ -116,6 +397,16 @@ extern int thread_free_all(pid_t pid);
  */
 extern struct context *thread_get_ctx(tid_t tid);
 
+/**
+ * @brief Gets a thread.
+ *
+ * @param tid ID of the target thread.
+ *
+ * @returns Upon successful completion, a pointer to the target thread is
+ * returned. Upon failure, NULL is returned instead.
+ */
+extern struct thread *thread_get(tid_t tid);
+
 /**
  * @brief Gets the currently running thread.
  *
@@ -140,11 +431,47 @@ extern pid_t thread_get_pid(tid_t tid);
  */
 extern void thread_yield(void);
 
+/**
+ * @brief Yields the CPU to a thread.
+ *
+ * @param tid ID of the target thread.
+ *
+ * @returns Upon successful completion, zero is returned. If the target thread
+ * is not ready, -EAGAIN is returned after yielding as usual. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int thread_yield_to(tid_t tid);
+
 /**
  * @brief Puts the calling thread to sleep.
  */
 extern void thread_sleep(void);
 
+/**
+ * @brief Puts the calling thread to sleep and yields the CPU to a thread.
+ *
+ * @param tid ID of the target thread.
+ */
+extern void thread_sleep_to(tid_t tid);
+
+/**
+ * @brief Puts the calling thread to sleep, with a timeout.
+ *
+ * @param ticks Maximum number of timer ticks to sleep, or TIMEOUT_INFINITE.
+ *
+ * @returns Upon successful completion, zero is returned. If the timeout
+ * expires before the calling thread is woken up, -ETIMEDOUT is returned
+ * instead.
+ */
+extern int thread_sleep_timeout(unsigned ticks);
+
+/**
+ * @brief Puts the calling thread to sleep for a number of timer ticks.
+ *
+ * @param ticks Number of timer ticks to sleep.
+ */
+extern void thread_sleep_ticks(unsigned ticks);
+
 /**
  * @brief Wakes up a thread.
  *
@@ -186,6 +513,19 @@ extern void thread_exit(void *retval);
  */
 extern int thread_join(tid_t tid, void **retval);
 
+/**
+ * @brief Waits for the target thread to terminate, with a timeout.
+ *
+ * @param tid    ID of the target thread.
+ * @param retval Location to store the return value of the target thread.
+ * @param ticks  Maximum number of timer ticks to wait, or TIMEOUT_INFINITE.
+ *
+ * @returns Upon successful completion, zero is returned. If the target thread
+ * does not terminate in time, -ETIMEDOUT is returned. Upon failure, a negative
+ * number is returned instead.
+ */
+extern int thread_join_timeout(tid_t tid, void **retval, unsigned ticks);
+
 /**
  * @brief Detaches the target thread.
  *
@@ -196,4 +536,138 @@ extern int thread_join(tid_t tid, void **retval);
  */
 extern int thread_detach(tid_t tid);
 
+/**
+ * @brief Sets the static priority of a thread.
+ *
+ * @param tid  ID of the target thread.
+ * @param prio New priority.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_setprio(tid_t tid, int prio);
+
+/**
+ * @brief Gets the static priority of a thread.
+ *
+ * @param tid ID of the target thread.
+ *
+ * @returns Upon successful completion, the static priority of the target
+ * thread is returned. Upon failure, a negative number is returned instead.
+ */
+extern int thread_getprio(tid_t tid);
+
+/**
+ * @brief Lends a priority to a thread.
+ *
+ * @param tid  ID of the target thread.
+ * @param prio Priority to lend.
+ */
+extern void thread_prio_inherit(tid_t tid, int prio);
+
+/**
+ * @brief Drops any priority lent to a thread.
+ *
+ * @param tid  ID of the target thread.
+ * @param prio Priority that is still lent to the target thread.
+ */
+extern void thread_prio_restore(tid_t tid, int prio);
+
+/**
+ * @brief Gets the effective priority of the calling thread.
+ *
+ * @returns The effective priority of the calling thread.
+ */
+extern int thread_prio_curr(void);
+
+/**
+ * @brief Sets the quantum of a thread.
+ *
+ * @param tid     ID of the target thread.
+ * @param quantum New quantum (in timer ticks), or THREAD_QUANTUM_ADAPTIVE.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_setquantum(tid_t tid, unsigned quantum);
+
+/**
+ * @brief Gets quantum information of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for quantum information.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_getquantum(tid_t tid, struct thread_quantum *buf);
+
+/**
+ * @brief Sets the TLS base address of the calling thread.
+ *
+ * @param base Base address of the TLS segment. If zero, the calling thread
+ *             is left without TLS.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int thread_set_tls(word_t base);
+
+/**
+ * @brief Sets the bound of address space affinity.
+ *
+ * @param bound New bound. If zero, address space affinity is turned off.
+ *
+ * @returns Upon successful completion, the previous bound is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_set_affinity(unsigned bound);
+
+/**
+ * @brief Sets the real-time parameters of a thread.
+ *
+ * @param tid    ID of the target thread.
+ * @param params New real-time parameters. A zero period moves the target
+ *               thread back to the regular scheduling class.
+ *
+ * @returns Upon successful completion, zero is returned. If the target thread
+ * is not admitted, -EBUSY is returned. Upon failure, a negative number is
+ * returned instead.
+ */
+extern int thread_setrt(tid_t tid, const struct thread_rt *params);
+
+/**
+ * @brief Gets the real-time parameters of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for real-time parameters.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_getrt(tid_t tid, struct thread_rt *buf);
+
+/**
+ * @brief Sets the fair share parameters of a process.
+ *
+ * @param pid    ID of the target process.
+ * @param params New fair share parameters. A zero quota lifts the cap of the
+ *               target process.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative number is returned instead.
+ */
+extern int thread_setshare(pid_t pid, const struct thread_share *params);
+
+/**
+ * @brief Gets the fair share parameters of a process.
+ *
+ * @param pid ID of the target process.
+ * @param buf Storage location for fair share parameters.
+ *
+ * @returns Upon successful completion, zero is returned.
+ * Upon failure, a negative number is returned instead.
+ */
+extern int thread_getshare(pid_t pid, struct thread_share *buf);
+
 #endif /* NANVIX_KERNEL_PM_THREAD_H_ */
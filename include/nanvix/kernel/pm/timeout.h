@@ -0,0 +1,145 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef NANVIX_KERNEL_PM_TIMEOUT_H_
+#define NANVIX_KERNEL_PM_TIMEOUT_H_
+
+#include <nanvix/kernel/hal.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Infinite timeout.
+ */
+#define TIMEOUT_INFINITE ((unsigned)-1)
+
+/**
+ * @brief Timeout.
+ *
+ * @details Pending timeouts are kept in a hierarchical timer wheel, thus
+ * setting, clearing and expiring a timeout takes constant time.
+ */
+struct timeout {
+    uint64_t expires;      /** Expiration time (in ticks). */
+    void (*fn)(void *arg); /** Expiration handler.         */
+    void *arg;             /** Argument of the handler.    */
+    struct timeout **head; /** Slot of the timer wheel.    */
+    struct timeout *prev;  /** Previous timeout in slot.   */
+    struct timeout *next;  /** Next timeout in slot.       */
+};
+
+/**
+ * @brief Initializes a timeout.
+ *
+ * @param to  Target timeout.
+ * @param fn  Expiration handler.
+ * @param arg Argument of the expiration handler.
+ */
+static inline void timeout_init(struct timeout *to, void (*fn)(void *arg),
+                                void *arg)
+{
+    to->expires = 0;
+    to->fn = fn;
+    to->arg = arg;
+    to->head = NULL;
+    to->prev = NULL;
+    to->next = NULL;
+}
+
+/**
+ * @brief Asserts whether a timeout is pending.
+ *
+ * @param to Target timeout.
+ *
+ * @returns True if the target timeout is pending, and false otherwise.
+ */
+static inline bool timeout_pending(const struct timeout *to)
+{
+    return (to->head != NULL);
+}
+
+/**
+ * @brief Gets the deadline of a timeout.
+ *
+ * @param ticks Number of timer ticks from now, or TIMEOUT_INFINITE.
+ *
+ * @returns The time (in timer ticks) at which a timeout of @p ticks timer
+ * ticks expires. If @p ticks is TIMEOUT_INFINITE, UINT64_MAX is returned.
+ */
+static inline uint64_t timeout_deadline(unsigned ticks)
+{
+    return ((ticks == TIMEOUT_INFINITE) ? UINT64_MAX
+                                        : interrupts_get_ticks() + ticks);
+}
+
+/**
+ * @brief Gets the number of timer ticks left until a deadline.
+ *
+ * @param deadline Target deadline (in timer ticks).
+ *
+ * @returns The number of timer ticks left until @p deadline, which is zero if
+ * it has passed. If there is no deadline, TIMEOUT_INFINITE is returned.
+ */
+static inline unsigned timeout_remaining(uint64_t deadline)
+{
+    const uint64_t now = interrupts_get_ticks();
+
+    if (deadline == UINT64_MAX) {
+        return (TIMEOUT_INFINITE);
+    }
+
+    if (now >= deadline) {
+        return (0);
+    }
+
+    // Clamp long waits, which are then waited in parts.
+    if ((deadline - now) >= TIMEOUT_INFINITE) {
+        return (TIMEOUT_INFINITE - 1);
+    }
+
+    return ((unsigned)(deadline - now));
+}
+
+/**
+ * @brief Sets a timeout.
+ *
+ * @param to    Target timeout.
+ * @param ticks Number of timer ticks from now.
+ *
+ * @details If the target timeout is pending, it is set again. The expiration
+ * handler runs in interrupt context, with the kernel lock held.
+ */
+extern void timeout_set(struct timeout *to, unsigned ticks);
+
+/**
+ * @brief Clears a timeout.
+ *
+ * @param to Target timeout.
+ *
+ * @details This function does nothing if the target timeout is not pending.
+ */
+extern void timeout_clear(struct timeout *to);
+
+/**
+ * @brief Expires all timeouts up to a point in time.
+ *
+ * @param now Current time (in timer ticks).
+ */
+extern void timeout_expire(uint64_t now);
+
+/**
+ * @brief Gets the number of timer ticks until the next timeout expires.
+ *
+ * @returns The number of timer ticks until the next timeout may expire. If no
+ * timeout is pending, TIMEOUT_INFINITE is returned instead.
+ */
+extern unsigned timeout_next(void);
+
+/**
+ * @brief Initializes the timer wheel.
+ */
+extern void timeout_wheel_init(void);
+
+#endif /* NANVIX_KERNEL_PM_TIMEOUT_H_ */
@@ -54,7 +54,8 @@ function run_qemu
 	local cmd=""
 
 	# Target configuration.
-	local MEMSIZE=256M # Memory Size
+	local MEMSIZE=256M        # Memory Size
+	local SMP=${NCORES:-1}    # Number of Cores
 
 	if [ $target == "i386" ]; then
 		machine="-machine pc"
@@ -65,6 +66,7 @@ function run_qemu
 			-serial stdio
 			-display none
 			-m $MEMSIZE
+			-smp $SMP
 			-mem-prealloc"
 
 	cmd="$qemu_cmd -gdb tcp::$GDB_PORT"
@@ -104,6 +106,7 @@ then
 	echo "IMAGE       = $IMAGE"
 	echo "MODE        = $MODE"
 	echo "TIMEOUT     = $TIMEOUT"
+	echo "NCORES      = ${NCORES:-1}"
 	echo "====================================================================="
 fi
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/cc.h>
+#include <nanvix/kernel/config.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <stdbool.h>
+#include <stdnoreturn.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Name of this module.
+ */
+#define MODULE_NAME "[hal][cpu][core]"
+
+/**
+ * @brief Owner of the kernel lock when no core holds it.
+ */
+#define KLOCK_NO_OWNER KERNEL_CORES_MAX
+
+/**
+ * @brief Time window for application cores to come online (in microseconds).
+ */
+#define CORES_BOOT_TIMEOUT 100000
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Kernel lock.
+ */
+static struct {
+    spinlock_t lock;         /** Underlying spinlock.    */
+    volatile unsigned owner; /** Core that holds it.     */
+    unsigned depth;          /** Depth of the owner.     */
+} klock = {SPINLOCK_UNLOCKED, KLOCK_NO_OWNER, 0};
+
+/**
+ * @brief Lock of the boot window of application cores.
+ */
+static spinlock_t boot_lock = SPINLOCK_UNLOCKED;
+
+/**
+ * @brief Are application cores allowed to come online?
+ */
+static volatile bool booting = false;
+
+/**
+ * @brief Number of cores that are online.
+ */
+static volatile unsigned online = 1;
+
+/*============================================================================*
+ * Extern Declarations                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Page directory that application cores start with.
+ *
+ * @note This is defined in assembly code.
+ */
+extern paddr_t ap_pgdir;
+
+/**
+ * @brief Kernel main function of application cores.
+ */
+extern noreturn void kmain_ap(unsigned coreid);
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Gets the ID of the underlying core. Each core loads its own TSS,
+ * thus the ID is inferred from the TSS selector. The master core is assumed
+ * until a TSS is loaded.
+ */
+unsigned core_get_id(void)
+{
+    word_t sel = 0;
+
+    asm volatile("str %0" : "=r"(sel));
+
+    return ((sel == 0) ? CORE_MASTER : gdt_tss_coreid(sel));
+}
+
+/**
+ * @details Gets the number of cores that are online.
+ */
+unsigned cores_online(void)
+{
+    return (online);
+}
+
+/**
+ * @details Starts application cores. There is no firmware table to tell how
+ * many cores there are, thus all other cores are started at once, and those
+ * that come online within a fixed time window are used.
+ */
+void cores_start(void)
+{
+    static bool started = false;
+
+    if (started) {
+        return;
+    }
+    started = true;
+
+    kprintf(MODULE_NAME " INFO: starting application cores...");
+
+    // Application cores share the address space of the master core.
+    ap_pgdir = cr3_read();
+    booting = true;
+    __sync_synchronize();
+
+    lapic_startup_broadcast(LAPIC_STARTUP_BASE);
+
+    for (int i = 0; (i < CORES_BOOT_TIMEOUT) && (online < KERNEL_CORES_MAX);
+         i++) {
+        iowait();
+    }
+
+    // Close the boot window.
+    spinlock_lock(&boot_lock);
+    booting = false;
+    spinlock_unlock(&boot_lock);
+
+    kprintf(MODULE_NAME " INFO: %d core(s) online", online);
+}
+
+/**
+ * @details Interrupts all other cores that are online with an inter-processor
+ * interrupt.
+ */
+void cores_kick(void)
+{
+    if (online > 1) {
+        lapic_ipi_broadcast(IPI_GATE);
+    }
+}
+
+/**
+ * @details Brings the application core @p coreid online, if the boot window is
+ * still open, and runs the kernel on it. Otherwise, the core is left halted.
+ *
+ * @note This function is called from assembly code.
+ */
+noreturn void do_core_start(unsigned coreid)
+{
+    spinlock_lock(&boot_lock);
+
+    if (!booting) {
+        spinlock_unlock(&boot_lock);
+        while (true) {
+            asm volatile("cli; hlt");
+        }
+    }
+
+    cpu_core_init(coreid);
+    online++;
+
+    spinlock_unlock(&boot_lock);
+
+    kmain_ap(coreid);
+}
+
+/**
+ * @details Acquires the kernel lock. If the underlying core holds it already,
+ * the depth of the kernel lock is increased instead.
+ */
+void klock_acquire(void)
+{
+    const unsigned coreid = core_get_id();
+
+    if (klock.owner != coreid) {
+        spinlock_lock(&klock.lock);
+        klock.owner = coreid;
+        klock.depth = 0;
+    }
+
+    klock.depth++;
+}
+
+/**
+ * @details Releases one level of the kernel lock. The kernel lock is released
+ * once its depth drops to zero.
+ */
+void klock_release(void)
+{
+    KASSERT(klock.owner == core_get_id());
+
+    if (--klock.depth == 0) {
+        klock.owner = KLOCK_NO_OWNER;
+        spinlock_unlock(&klock.lock);
+    }
+}
+
+/**
+ * @details Gets the depth of the kernel lock held by the underlying core. If
+ * the underlying core does not hold the kernel lock, zero is returned.
+ */
+unsigned klock_save(void)
+{
+    return ((klock.owner == core_get_id()) ? klock.depth : 0);
+}
+
+/**
+ * @details Sets the depth of the kernel lock held by the underlying core to
+ * @p depth. This is used to carry the depth of the kernel lock of a thread
+ * across context switches.
+ */
+void klock_restore(unsigned depth)
+{
+    if (depth == 0) {
+        if (klock.owner == core_get_id()) {
+            klock.depth = 1;
+            klock_release();
+        }
+        return;
+    }
+
+    klock_acquire();
+    klock.depth = depth;
+}
+
+/**
+ * @details Releases the kernel lock for a moment, and acquires it back at the
+ * same depth.
+ */
+void klock_relax(void)
+{
+    const unsigned depth = klock_save();
+
+    klock_restore(0);
+    asm volatile("pause");
+    klock_restore(depth);
+}
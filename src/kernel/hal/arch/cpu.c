@@ -11,6 +11,20 @@
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 
+/*============================================================================*
+ * Extern Declarations                                                        *
+ *============================================================================*/
+
+/**
+ * @name Entry Point of Application Cores
+ *
+ * @note These are defined in assembly code.
+ */
+/**@{*/
+extern byte_t __ap_trampoline[];     /** Start. */
+extern byte_t __ap_trampoline_end[]; /** End.   */
+/**@}*/
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
@@ -35,6 +49,32 @@ void cpu_init(void)
     gdt_init();
     const unsigned kernel_cs = gdt_kernel_cs();
     const unsigned hwint_off = idt_init(kernel_cs);
+    sysenter_init(kernel_cs);
+    fpu_init();
     lpic_init(hwint_off);
+
+    // Place the entry point of application cores in low memory, while it is
+    // still reachable without paging.
+    if (lapic_init(true) == 0) {
+        __memcpy((void *)LAPIC_STARTUP_BASE,
+                 __ap_trampoline,
+                 __ap_trampoline_end - __ap_trampoline);
+    }
+
     timer_init(KERNEL_TIMER_FREQUENCY);
 }
+
+/**
+ * @details Initializes the application core @p coreid. Structures that are
+ * shared by all cores are initialized by cpu_init() before.
+ */
+void cpu_core_init(unsigned coreid)
+{
+    kprintf("[hal] initializing core %d...", coreid);
+
+    gdt_core_init(coreid);
+    idt_core_init();
+    sysenter_init(gdt_kernel_cs());
+    fpu_core_init();
+    lapic_init(false);
+}
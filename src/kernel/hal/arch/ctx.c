@@ -49,3 +49,41 @@ int context_create(struct context *ctx, const void *pgdir, const void *kbp,
 
     return (0);
 }
+
+/**
+ * @details Forges a kernel stack for a kernel thread. The context switch
+ * returns to @p kernel_func, which sees a null return address.
+ */
+void *context_forge_stack(void *kernel_stack, void (*kernel_func)(void))
+{
+    // Check for invalid kernel stack.
+    if (kernel_stack == NULL) {
+        kprintf("[hal] ERROR: invalid kernel stack");
+        return (NULL);
+    }
+
+    // Check for invalid kernel function.
+    if (kernel_func == NULL) {
+        kprintf("[hal] ERROR: invalid kernel function");
+        return (NULL);
+    }
+
+    __memset(kernel_stack, 0, PAGE_SIZE);
+
+    word_t *kstackp = (word_t *)((word_t)kernel_stack + PAGE_SIZE);
+    *--kstackp = 0;                   /* return address */
+    *--kstackp = (word_t)kernel_func; /* kernel eip     */
+
+    return (kstackp);
+}
+
+/**
+ * @details Checks if switching to the execution context pointed to by @p to
+ * loads another page directory. This follows what `__context_switch()` does:
+ * contexts without a page directory borrow the one that is loaded, and page
+ * directories that are loaded already are not loaded again.
+ */
+bool context_switches_pgdir(const struct context *to)
+{
+    return ((to->cr3 != 0) && (to->cr3 != cr3_read()));
+}
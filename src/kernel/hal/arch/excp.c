@@ -62,3 +62,12 @@ int exception_get_num(const struct exception *excp)
 {
     return (excp->num);
 }
+
+/**
+ * @details This function gets the faulting address stored in the exception
+ * information structure pointed to by @p excp.
+ */
+vaddr_t exception_get_addr(const struct exception *excp)
+{
+    return (excp->addr);
+}
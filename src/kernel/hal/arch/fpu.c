@@ -0,0 +1,289 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/config.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/libcore.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Is lazy FPU switching enabled?
+ */
+static bool enabled = false;
+
+/**
+ * @brief FPU state right after initialization.
+ */
+static struct fpu_state initial;
+
+/**
+ * @brief FPU state that is currently loaded in the FPU of each core.
+ */
+static struct fpu_state *owner[KERNEL_CORES_MAX];
+
+/**
+ * @brief FPU state of the running execution context of each core.
+ */
+static struct fpu_state *current[KERNEL_CORES_MAX];
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Reads the CR0 register.
+ *
+ * @returns The value of the CR0 register.
+ */
+static inline uint32_t cr0_read(void)
+{
+    uint32_t cr0;
+    asm volatile("movl %%cr0, %0" : "=r"(cr0));
+    return (cr0);
+}
+
+/**
+ * @brief Writes to the CR0 register.
+ *
+ * @param cr0 Value to write.
+ */
+static inline void cr0_write(uint32_t cr0)
+{
+    asm volatile("movl %0, %%cr0" : : "r"(cr0));
+}
+
+/**
+ * @brief Reads the CR4 register.
+ *
+ * @returns The value of the CR4 register.
+ */
+static inline uint32_t cr4_read(void)
+{
+    uint32_t cr4;
+    asm volatile("movl %%cr4, %0" : "=r"(cr4));
+    return (cr4);
+}
+
+/**
+ * @brief Writes to the CR4 register.
+ *
+ * @param cr4 Value to write.
+ */
+static inline void cr4_write(uint32_t cr4)
+{
+    asm volatile("movl %0, %%cr4" : : "r"(cr4));
+}
+
+/**
+ * @brief Saves the state of the FPU.
+ *
+ * @param state Storage location for FPU state.
+ */
+static inline void fxsave(struct fpu_state *state)
+{
+    asm volatile("fxsave %0" : "=m"(*state));
+}
+
+/**
+ * @brief Restores the state of the FPU.
+ *
+ * @param state FPU state to restore.
+ */
+static inline void fxrstor(const struct fpu_state *state)
+{
+    asm volatile("fxrstor %0" : : "m"(*state));
+}
+
+/**
+ * @brief Enables the FPU and the FXSAVE/FXRSTOR instructions in the
+ * underlying core.
+ *
+ * @returns Upon successful completion, zero is returned. If the processor
+ * does not support FXSAVE/FXRSTOR, a negative number is returned instead.
+ */
+static int fpu_enable(void)
+{
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+
+    // Check if FXSAVE/FXRSTOR is supported.
+    cpuid(CPUID_LEAF_FEATURES, &eax, &ebx, &ecx, &edx);
+    if (!(edx & CPUID_FEATURES_EDX_FXSR)) {
+        kprintf("[hal][cpu] WARNING: fxsave not supported");
+        return (-1);
+    }
+
+    // Enable the FPU, and report its errors natively.
+    cr0_write((cr0_read() & ~(CR0_EM | CR0_TS)) | CR0_MP | CR0_NE);
+
+    // Enable FXSAVE/FXRSTOR and SSE instructions.
+    uint32_t cr4 = cr4_read() | CR4_OSFXSR;
+    if (edx & CPUID_FEATURES_EDX_SSE) {
+        cr4 |= CR4_OSXMMEXCPT;
+    }
+    cr4_write(cr4);
+
+    asm volatile("fninit");
+
+    return (0);
+}
+
+/**
+ * @brief Handles "coprocessor not available" exceptions.
+ *
+ * @details This exception is raised when the running execution context issues
+ * a floating-point or SIMD instruction while CR0.TS is set. The FPU state of
+ * its previous owner is saved, and the FPU state of the running execution
+ * context is restored. Other cores that still have the same FPU state loaded
+ * lose it, because it is about to change.
+ *
+ * @param excp Exception information.
+ * @param ctx  Interrupted execution context.
+ */
+static void do_fpu(const struct exception *excp, const struct context *ctx)
+{
+    const unsigned coreid = core_get_id();
+
+    UNUSED(excp);
+    UNUSED(ctx);
+
+    asm volatile("clts");
+
+    // FPU state is already loaded.
+    if (owner[coreid] == current[coreid]) {
+        return;
+    }
+
+    if (owner[coreid] != NULL) {
+        fxsave(owner[coreid]);
+    }
+    fxrstor((current[coreid] != NULL) ? current[coreid] : &initial);
+
+    for (unsigned i = 0; i < KERNEL_CORES_MAX; i++) {
+        if ((i != coreid) && (owner[i] == current[coreid])) {
+            owner[i] = NULL;
+        }
+    }
+    owner[coreid] = current[coreid];
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Enables the FPU and the FXSAVE/FXRSTOR instructions, takes a
+ * snapshot of the initial FPU state, and registers the handler for
+ * "coprocessor not available" exceptions.
+ */
+int fpu_init(void)
+{
+    kprintf("[hal][cpu] initializing fpu...");
+
+    if (fpu_enable() != 0) {
+        return (-1);
+    }
+
+    fxsave(&initial);
+
+    KASSERT(exception_register(EXCEPTION_COPROC_NOT_AVAILABLE, do_fpu) == 0);
+
+    // The FPU state loaded now belongs to no one.
+    for (unsigned coreid = 0; coreid < KERNEL_CORES_MAX; coreid++) {
+        owner[coreid] = NULL;
+        current[coreid] = NULL;
+    }
+    cr0_write(cr0_read() | CR0_TS);
+
+    enabled = true;
+
+    return (0);
+}
+
+/**
+ * @details Enables the FPU and the FXSAVE/FXRSTOR instructions in the
+ * underlying application core, if lazy FPU switching is enabled.
+ */
+void fpu_core_init(void)
+{
+    if (!enabled) {
+        return;
+    }
+
+    KASSERT(fpu_enable() == 0);
+
+    cr0_write(cr0_read() | CR0_TS);
+}
+
+/**
+ * @details Initializes the FPU state pointed to by @p state with the FPU state
+ * right after initialization.
+ */
+void fpu_state_init(struct fpu_state *state)
+{
+    KASSERT(state != NULL);
+
+    __memcpy(state, &initial, sizeof(struct fpu_state));
+}
+
+/**
+ * @details Records that the FPU state pointed to by @p state belongs to the
+ * execution context that is about to run. FPU state is not saved here: CR0.TS
+ * is set instead, unless @p state is already loaded in the FPU. If more than
+ * one core is online, the outgoing execution context may resume on another
+ * core, thus its FPU state is saved right away if it is loaded.
+ */
+void fpu_switch(struct fpu_state *state)
+{
+    const unsigned coreid = core_get_id();
+
+    if (!enabled) {
+        return;
+    }
+
+    if ((cores_online() > 1) && (current[coreid] != state) &&
+        (current[coreid] != NULL) && (owner[coreid] == current[coreid])) {
+        asm volatile("clts");
+        fxsave(owner[coreid]);
+    }
+
+    current[coreid] = state;
+
+    if (current[coreid] == owner[coreid]) {
+        asm volatile("clts");
+    } else {
+        cr0_write(cr0_read() | CR0_TS);
+    }
+}
+
+/**
+ * @details Releases the FPU state pointed to by @p state in all cores, so that
+ * it is not saved anymore. This should be called before the underlying storage
+ * is reused.
+ */
+void fpu_release(struct fpu_state *state)
+{
+    for (unsigned coreid = 0; coreid < KERNEL_CORES_MAX; coreid++) {
+        if (owner[coreid] == state) {
+            owner[coreid] = NULL;
+        }
+
+        if (current[coreid] == state) {
+            current[coreid] = NULL;
+        }
+    }
+}
@@ -8,6 +8,7 @@
  *============================================================================*/
 
 #include <nanvix/cc.h>
+#include <nanvix/kernel/config.h>
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 #include <nanvix/libcore.h>
@@ -19,7 +20,7 @@
 /**
  * @brief Number of entries in the GDT.
  */
-#define GDT_LENGTH 6
+#define GDT_LENGTH (GDT_TSS + KERNEL_CORES_MAX)
 
 /**
  * @name GDT Entries
@@ -30,18 +31,20 @@
 #define GDT_DATA_DPL0 2 /** Data DPL 0. */
 #define GDT_CODE_DPL3 3 /** Code DPL 3. */
 #define GDT_DATA_DPL3 4 /** Data DPL 3. */
-#define GDT_TSS 5       /** TSS.        */
+#define GDT_TLS 5       /** TLS DPL 3.  */
+#define GDT_TSS 6       /** TSS.        */
 /**@}*/
 
 /**
  * @name GDT Segment Selectors
  */
 /**@{*/
-#define KERNEL_CS (GDTE_SIZE * GDT_CODE_DPL0)   /** Kernel code. */
-#define KERNEL_DS (GDTE_SIZE * GDT_DATA_DPL0)   /** Kernel data. */
-#define USER_CS (GDTE_SIZE * GDT_CODE_DPL3 + 3) /** User code.   */
-#define USER_DS (GDTE_SIZE * GDT_DATA_DPL3 + 3) /** User data.   */
-#define TSS (GDTE_SIZE * GDT_TSS)               /** TSS.         */
+#define KERNEL_CS (GDTE_SIZE * GDT_CODE_DPL0)          /** Kernel code. */
+#define KERNEL_DS (GDTE_SIZE * GDT_DATA_DPL0)          /** Kernel data. */
+#define USER_CS (GDTE_SIZE * GDT_CODE_DPL3 + 3)        /** User code.   */
+#define USER_DS (GDTE_SIZE * GDT_DATA_DPL3 + 3)        /** User data.   */
+#define USER_GS (GDTE_SIZE * GDT_TLS + 3)              /** User TLS.    */
+#define TSS(coreid) (GDTE_SIZE * (GDT_TSS + (coreid))) /** TSS.         */
 /**@}*/
 
 /*============================================================================*
@@ -49,14 +52,17 @@
  *============================================================================*/
 
 /**
- * @brief Global Descriptor Table (GDT).
+ * @brief Global Descriptor Tables (GDTs).
+ *
+ * @details Each core has its own copy of the GDT, so that the TLS segment of
+ * each core may have a different base address under the same selector.
  */
-static struct gdte gdt[GDT_LENGTH];
+static struct gdte gdt[KERNEL_CORES_MAX][GDT_LENGTH];
 
 /**
- * @brief Pointer to Global Descriptor Table (GDTPTR)
+ * @brief Pointers to Global Descriptor Tables (GDTPTRs).
  */
-static struct gdtptr gdtptr;
+static struct gdtptr gdtptr[KERNEL_CORES_MAX];
 
 /*============================================================================*
  * Private Functions                                                          *
@@ -73,8 +79,8 @@ static void gdt_load(const struct gdtptr *_gdtptr)
 
     asm volatile("mov %0, %%eax;\
 			lgdt (%%eax);\
-			ljmp %1, $reload_cs;\
-			reload_cs:\
+			ljmp %1, $1f;\
+			1:\
 			movw %2, %%ax;\
 			movw %%ax, %%ds;\
 			movw %%ax, %%es;\
@@ -87,7 +93,7 @@ static void gdt_load(const struct gdtptr *_gdtptr)
 }
 
 /**
- * @brief Sets an entry of the GDT.
+ * @brief Sets an entry of the GDT of the master core.
  *
  * @param n           Target entry.
  * @param base        Base address of segment.
@@ -98,17 +104,19 @@ static void gdt_load(const struct gdtptr *_gdtptr)
 static void set_gdte(int n, unsigned base, unsigned limit, unsigned granularity,
                      unsigned access)
 {
+    struct gdte *gdte = &gdt[CORE_MASTER][n];
+
     // Set the base address of the segment.
-    gdt[n].base_low = (base & 0xffffff);
-    gdt[n].base_high = (base >> 24) & 0xff;
+    gdte->base_low = (base & 0xffffff);
+    gdte->base_high = (base >> 24) & 0xff;
 
     // Set the limit of the segment.
-    gdt[n].limit_low = (limit & 0xffff);
-    gdt[n].limit_high = (limit >> 16) & 0xf;
+    gdte->limit_low = (limit & 0xffff);
+    gdte->limit_high = (limit >> 16) & 0xf;
 
     // Set the granularity of the segment.
-    gdt[n].granularity = granularity;
-    gdt[n].access = access;
+    gdte->granularity = granularity;
+    gdte->access = access;
 }
 
 /*============================================================================*
@@ -140,7 +148,52 @@ unsigned gdt_user_ds(void)
 }
 
 /**
- * @details Initializes the Global Descriptor Table (GDT).
+ * @details Gets the segment selector for the user TLS segment.
+ */
+unsigned gdt_user_gs(void)
+{
+    return (USER_GS);
+}
+
+/**
+ * @details Sets the base address of the TLS segment of the underlying core to
+ * @p base, and loads the TLS segment in the GS register. The GS register has
+ * to be loaded again, because the processor caches the base address of a
+ * segment when its selector is loaded.
+ */
+void gdt_tls_switch(word_t base)
+{
+    struct gdte *gdte = &gdt[core_get_id()][GDT_TLS];
+
+    gdte->base_low = (base & 0xffffff);
+    gdte->base_high = (base >> 24) & 0xff;
+
+    asm volatile("movw %w0, %%gs" : : "r"(USER_GS) : "memory");
+}
+
+/**
+ * @details Gets the ID of the core whose TSS is selected by @p tss_selector.
+ */
+unsigned gdt_tss_coreid(unsigned tss_selector)
+{
+    return ((tss_selector / GDTE_SIZE) - GDT_TSS);
+}
+
+/**
+ * @details Loads the Global Descriptor Table (GDT) and the Task State Segment
+ * (TSS) of the core @p coreid in the underlying core.
+ */
+void gdt_core_init(unsigned coreid)
+{
+    KASSERT(coreid < KERNEL_CORES_MAX);
+
+    gdt_load(&gdtptr[coreid]);
+    tss_load(TSS(coreid));
+}
+
+/**
+ * @details Initializes the Global Descriptor Tables (GDTs). There is one TSS
+ * for each core, and all GDTs hold the TSSs of all cores.
  */
 void gdt_init(void)
 {
@@ -150,12 +203,12 @@ void gdt_init(void)
     KASSERT_SIZE(sizeof(struct gdte), GDTE_SIZE);
     KASSERT_SIZE(sizeof(struct gdtptr), GDTPTR_SIZE);
 
-    // Initialize the TSS.
+    // Initialize the TSSs.
     const struct tss *tss = tss_init(KERNEL_DS);
 
     // Blank the GDT and GDTPTR structures.
     __memset(gdt, 0, sizeof(gdt));
-    __memset(&gdtptr, 0, GDTPTR_SIZE);
+    __memset(gdtptr, 0, sizeof(gdtptr));
 
     // Initialize GDT structure.
     set_gdte(GDT_NULL, 0, 0x00000, 0x0, 0x00);
@@ -163,15 +216,27 @@ void gdt_init(void)
     set_gdte(GDT_DATA_DPL0, 0, 0xfffff, 0xc, 0x92);
     set_gdte(GDT_CODE_DPL3, 0, 0xfffff, 0xc, 0xfa);
     set_gdte(GDT_DATA_DPL3, 0, 0xfffff, 0xc, 0xf2);
-    set_gdte(GDT_TSS, (unsigned)tss, TSS_SIZE, 0x00, 0x89);
-
-    // Initialize the GDTPTR structure.
-    gdtptr.size = sizeof(gdt) - 1;
-    gdtptr.ptr = (unsigned)gdt;
+    set_gdte(GDT_TLS, 0, 0xfffff, 0xc, 0xf2);
+    for (unsigned coreid = 0; coreid < KERNEL_CORES_MAX; coreid++) {
+        set_gdte(GDT_TSS + coreid,
+                 (unsigned)&tss[coreid],
+                 TSS_SIZE,
+                 0x00,
+                 0x89);
+    }
+
+    // Copy the GDT to other cores, and initialize the GDTPTR structures.
+    for (unsigned coreid = 0; coreid < KERNEL_CORES_MAX; coreid++) {
+        if (coreid != CORE_MASTER) {
+            __memcpy(gdt[coreid], gdt[CORE_MASTER], sizeof(gdt[CORE_MASTER]));
+        }
+        gdtptr[coreid].size = sizeof(gdt[coreid]) - 1;
+        gdtptr[coreid].ptr = (unsigned)gdt[coreid];
+    }
 
     // Load the GDT.
-    gdt_load(&gdtptr);
+    gdt_load(&gdtptr[CORE_MASTER]);
 
     // Load the TSS.
-    tss_load(TSS);
+    tss_load(TSS(CORE_MASTER));
 }
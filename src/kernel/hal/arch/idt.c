@@ -75,6 +75,16 @@ extern void _do_hwint15(void);
 extern void _do_kcall(void); /** Kernel Call */
 /**@}*/
 
+/**
+ * @name Local APIC Interrupt Hooks
+ *
+ * @note These are defined in assembly code.
+ */
+/**@{*/
+extern void _do_ipi(void);      /** Inter-Processor Interrupt */
+extern void _do_spurious(void); /** Spurious Interrupt        */
+/**@}*/
+
 /*============================================================================*
  * Private Variables                                                          *
  *============================================================================*/
@@ -202,6 +212,10 @@ unsigned idt_init(unsigned cs_sel)
     // Set kernel call interrupt.
     set_idte(TRAP_GATE, (unsigned)_do_kcall, cs_sel, 0xe, IDT_INT32);
 
+    // Set Local APIC interrupts.
+    set_idte(IPI_GATE, (unsigned)_do_ipi, cs_sel, 0x8, IDT_INT32);
+    set_idte(SPURIOUS_GATE, (unsigned)_do_spurious, cs_sel, 0x8, IDT_INT32);
+
     // Set IDT pointer.
     idtptr.size = sizeof(idt) - 1;
     idtptr.ptr = (unsigned)&idt;
@@ -211,3 +225,11 @@ unsigned idt_init(unsigned cs_sel)
 
     return (hwint_off);
 }
+
+/**
+ * @details Loads the Interrupt Descriptor Table (IDT) in the underlying core.
+ */
+void idt_core_init(void)
+{
+    idt_load(&idtptr);
+}
@@ -39,7 +39,8 @@ interrupt_handler_t interrupt_handlers[INTERRUPTS_NUM] = {NULL,
  *============================================================================*/
 
 /**
- * @details Forges an interrupt stack.
+ * @details Forges an interrupt stack. Only the forged frame is written, thus
+ * the rest of the kernel stack is left as is.
  */
 void *interrupt_forge_stack(void *user_stack, void *kernel_stack,
                             void (*user_func)(void), void (*kernel_func)(void))
@@ -68,8 +69,6 @@ void *interrupt_forge_stack(void *user_stack, void *kernel_stack,
         return (NULL);
     }
 
-    __memset(kernel_stack, 0, PAGE_SIZE);
-
     // Create a fake interrupt stack.
     word_t *kstackp = (word_t *)((word_t)kernel_stack + PAGE_SIZE);
     *--kstackp = gdt_user_ds();       /* user ds     */
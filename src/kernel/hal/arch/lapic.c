@@ -0,0 +1,206 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/cc.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Name of this module.
+ */
+#define MODULE_NAME "[hal][cpu][lapic]"
+
+/**
+ * @name Start-Up Delays (in microseconds)
+ */
+/**@{*/
+#define LAPIC_DELAY_INIT 10000  /** After INIT.         */
+#define LAPIC_DELAY_STARTUP 200 /** After each STARTUP. */
+/**@}*/
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Is the Local APIC enabled?
+ */
+static bool enabled = false;
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Reads a register of the Local APIC.
+ *
+ * @param reg Target register.
+ *
+ * @returns The value of the target register.
+ */
+static inline uint32_t lapic_read(unsigned reg)
+{
+    return (*(volatile uint32_t *)(LAPIC_BASE_PHYS + reg));
+}
+
+/**
+ * @brief Writes to a register of the Local APIC.
+ *
+ * @param reg   Target register.
+ * @param value Value to write.
+ */
+static inline void lapic_write(unsigned reg, uint32_t value)
+{
+    *(volatile uint32_t *)(LAPIC_BASE_PHYS + reg) = value;
+
+    // Wait for the write to complete.
+    lapic_read(LAPIC_ID);
+}
+
+/**
+ * @brief Busy waits for about @p usecs microseconds.
+ *
+ * @param usecs Number of microseconds.
+ */
+static void lapic_delay(unsigned usecs)
+{
+    // Each write to the diagnostic port takes about one microsecond.
+    while (usecs-- > 0) {
+        iowait();
+    }
+}
+
+/**
+ * @brief Sends an inter-processor interrupt.
+ *
+ * @param dest    ID of the Local APIC of the target core.
+ * @param command Interrupt command.
+ */
+static void lapic_ipi(unsigned dest, uint32_t command)
+{
+    lapic_write(LAPIC_ICR_HIGH, dest << 24);
+    lapic_write(LAPIC_ICR_LOW, command);
+
+    // Wait for the interrupt to be delivered.
+    while (lapic_read(LAPIC_ICR_LOW) & LAPIC_ICR_PENDING) {
+        noop();
+    }
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Gets the ID of the Local APIC of the underlying core.
+ */
+unsigned lapic_id(void)
+{
+    return (lapic_read(LAPIC_ID) >> 24);
+}
+
+/**
+ * @details Signals the end of an interrupt to the Local APIC.
+ */
+void lapic_eoi(void)
+{
+    lapic_write(LAPIC_EOI, 0);
+}
+
+/**
+ * @details Sends an inter-processor interrupt to all cores but the underlying
+ * one, through interrupt vector @p vector. If the Local APIC is not enabled,
+ * this function does nothing.
+ */
+void lapic_ipi_broadcast(unsigned vector)
+{
+    if (!enabled) {
+        return;
+    }
+
+    lapic_ipi(0, LAPIC_ICR_ALL_BUT_SELF | LAPIC_ICR_FIXED | vector);
+}
+
+/**
+ * @details Starts all cores but the underlying one with the INIT, STARTUP,
+ * STARTUP sequence. Cores start executing in real mode at the physical address
+ * @p entry.
+ */
+void lapic_startup_broadcast(paddr_t entry)
+{
+    const uint32_t vector = (entry >> PAGE_SHIFT) & 0xff;
+
+    KASSERT((entry & (PAGE_SIZE - 1)) == 0);
+
+    if (!enabled) {
+        return;
+    }
+
+    lapic_ipi(0,
+              LAPIC_ICR_ALL_BUT_SELF | LAPIC_ICR_INIT | LAPIC_ICR_ASSERT |
+                  LAPIC_ICR_LEVEL);
+    lapic_delay(LAPIC_DELAY_INIT);
+
+    for (int i = 0; i < 2; i++) {
+        lapic_ipi(0, LAPIC_ICR_ALL_BUT_SELF | LAPIC_ICR_STARTUP | vector);
+        lapic_delay(LAPIC_DELAY_STARTUP);
+    }
+}
+
+/**
+ * @details Initializes the Local APIC of the underlying core. Hardware
+ * interrupts of the legacy PIC are routed to the master core only, and the
+ * timer of the Local APIC is left masked.
+ */
+int lapic_init(bool master)
+{
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+
+    kprintf(MODULE_NAME " initializing lapic...");
+
+    // Check if the Local APIC is present.
+    cpuid(CPUID_LEAF_FEATURES, &eax, &ebx, &ecx, &edx);
+    if (!(edx & CPUID_FEATURES_EDX_APIC)) {
+        kprintf(MODULE_NAME " WARNING: lapic not supported");
+        return (-1);
+    }
+
+    // Accept interrupts of all priorities.
+    lapic_write(LAPIC_TPR, 0);
+
+    if (master) {
+        lapic_write(LAPIC_LVT_LINT0, LAPIC_LVT_EXTINT);
+        lapic_write(LAPIC_LVT_LINT1, LAPIC_LVT_NMI);
+    } else {
+        lapic_write(LAPIC_LVT_LINT0, LAPIC_LVT_MASKED);
+        lapic_write(LAPIC_LVT_LINT1, LAPIC_LVT_MASKED);
+    }
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED);
+    lapic_write(LAPIC_LVT_ERROR, LAPIC_LVT_MASKED);
+
+    // Clear errors. This takes back-to-back writes.
+    lapic_write(LAPIC_ESR, 0);
+    lapic_write(LAPIC_ESR, 0);
+
+    lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | SPURIOUS_GATE);
+    lapic_eoi();
+
+    enabled = true;
+
+    return (0);
+}
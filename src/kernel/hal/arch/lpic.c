@@ -233,6 +233,19 @@ void lpic_disable(void)
     asm("cli");
 }
 
+/**
+ * @details This function enables all hardware interrupts in the underlying
+ * core and halts it until an interrupt is delivered. Because interrupts are
+ * only recognized after the instruction that follows STI, no interrupt may
+ * slip in between enabling interrupts and halting.
+ */
+void lpic_idle(void)
+{
+    asm volatile("sti\n"
+                 "hlt\n"
+                 "cli");
+}
+
 /**
  * @details This function initializes the programmable interrupt controller of
  * the underlying core. Upon completion, it raises the interrupt level to the
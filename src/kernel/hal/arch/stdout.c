@@ -3,9 +3,92 @@
  * Licensed under the MIT License.
  */
 
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
 #include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/libcore.h>
+#include <stdbool.h>
 #include <stddef.h>
 
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Size of the output ring (in bytes).
+ *
+ * @note This should be a power of two.
+ */
+#define STDOUT_RING_SIZE 4096
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Output ring.
+ */
+static struct {
+    unsigned head;              /** Next byte to transmit. */
+    unsigned tail;              /** Next free byte.        */
+    char buf[STDOUT_RING_SIZE]; /** Buffer.                */
+} ring;
+
+/**
+ * @brief Are asynchronous writes enabled?
+ */
+static bool async = false;
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Moves as many bytes from the output ring to the UART as it accepts
+ * without blocking.
+ *
+ * @details The transmitter interrupt is left enabled while the output ring is
+ * not empty, so that draining resumes as soon as the transmitter is ready.
+ */
+static void stdout_drain(void)
+{
+    while (ring.head != ring.tail) {
+        const unsigned head = ring.head & (STDOUT_RING_SIZE - 1);
+        size_t len = ring.tail - ring.head;
+
+        // Transmit contiguous bytes only.
+        if (len > (STDOUT_RING_SIZE - head)) {
+            len = STDOUT_RING_SIZE - head;
+        }
+
+        const size_t n = uart_write_nonblock(&ring.buf[head], len);
+
+        // Transmitter is busy.
+        if (n == 0) {
+            break;
+        }
+
+        ring.head += n;
+    }
+
+    uart_tx_interrupt(ring.head != ring.tail);
+}
+
+/**
+ * @brief Handles interrupts of the standard output device.
+ */
+static void do_stdout(void)
+{
+    stdout_drain();
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
 /**
  * @details Initializes the standard output device.
  */
@@ -14,11 +97,83 @@ void stdout_init(void)
     uart_init(UART_PORT_0, UART_BAUD_38400);
 }
 
+/**
+ * @details Registers the interrupt handler that drains the output ring. Until
+ * this is called, asynchronous writes fall back to synchronous ones.
+ */
+void stdout_async_init(void)
+{
+    if (interrupt_register(INTERRUPT_COM1, do_stdout) != 0) {
+        kprintf("[hal][stdout] WARN: asynchronous writes are not available");
+        return;
+    }
+
+    async = true;
+}
+
 /**
  * @details Writes to the standard output device @p n bytes from the buffer
- * pointed to by @p buf.
+ * pointed to by @p buf. Pending asynchronous writes are flushed first, so that
+ * output is not reordered.
  */
 void stdout_write(const char *buf, size_t n)
 {
+    stdout_flush();
     uart_write(buf, n);
 }
+
+/**
+ * @details Appends @p n bytes from the buffer pointed to by @p buf to the
+ * output ring, which is drained by the interrupt handler of the standard
+ * output device. The calling thread only waits for the transmitter if the
+ * output ring runs full.
+ *
+ * @note This function should be called with interrupts disabled.
+ */
+size_t stdout_write_async(const char *buf, size_t n)
+{
+    size_t written = 0;
+
+    // Asynchronous writes are not enabled yet.
+    if (!async) {
+        stdout_write(buf, n);
+        return (n);
+    }
+
+    while (written < n) {
+        const unsigned tail = ring.tail & (STDOUT_RING_SIZE - 1);
+        size_t len = STDOUT_RING_SIZE - (ring.tail - ring.head);
+
+        // Ring is full, thus wait for the transmitter to make room.
+        if (len == 0) {
+            stdout_drain();
+            continue;
+        }
+
+        // Copy contiguous bytes only.
+        if (len > (STDOUT_RING_SIZE - tail)) {
+            len = STDOUT_RING_SIZE - tail;
+        }
+        if (len > (n - written)) {
+            len = n - written;
+        }
+
+        __memcpy(&ring.buf[tail], &buf[written], len);
+        ring.tail += len;
+        written += len;
+    }
+
+    stdout_drain();
+
+    return (written);
+}
+
+/**
+ * @details Waits until all bytes in the output ring are transmitted.
+ */
+void stdout_flush(void)
+{
+    while (ring.head != ring.tail) {
+        stdout_drain();
+    }
+}
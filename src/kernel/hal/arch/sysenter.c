@@ -0,0 +1,58 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Fast kernel call hook.
+ */
+extern void _do_kcall_fast(void);
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Initializes the fast kernel call entry point of the underlying
+ * core. The SYSENTER stack pointer is set to the location of the ring 0 stack
+ * pointer in the TSS of the underlying core, so that the entry hook may switch
+ * to the kernel stack of the running thread, which is kept up to date by
+ * __context_switch().
+ */
+int sysenter_init(unsigned kernel_cs)
+{
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+
+    kprintf("[hal][cpu] initializing sysenter...");
+
+    // Check if SYSENTER/SYSEXIT is supported.
+    cpuid(CPUID_LEAF_FEATURES, &eax, &ebx, &ecx, &edx);
+    if (!(edx & CPUID_FEATURES_EDX_MSR) || !(edx & CPUID_FEATURES_EDX_SEP)) {
+        kprintf("[hal][cpu] WARNING: sysenter not supported");
+        return (-1);
+    }
+
+    // SYSEXIT derives user segments from the kernel code segment.
+    KASSERT(gdt_user_cs() == ((kernel_cs + 2 * GDTE_SIZE) | 3));
+    KASSERT(gdt_user_ds() == ((kernel_cs + 3 * GDTE_SIZE) | 3));
+
+    msr_write(MSR_IA32_SYSENTER_CS, kernel_cs);
+    msr_write(MSR_IA32_SYSENTER_ESP, (word_t)&tss_get()->esp0);
+    msr_write(MSR_IA32_SYSENTER_EIP, (word_t)_do_kcall_fast);
+
+    return (0);
+}
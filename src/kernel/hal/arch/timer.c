@@ -34,6 +34,51 @@
 #define PIT_DATA 0x40 /** Data    */
 /**@}*/
 
+/**
+ * @name Control Bytes
+ */
+/**@{*/
+#define PIT_LATCH 0x00    /** Latch count of channel 0.               */
+#define PIT_ONESHOT 0x30  /** Channel 0, interrupt on terminal count. */
+#define PIT_PERIODIC 0x36 /** Channel 0, square wave generator.       */
+/**@}*/
+
+/**
+ * @brief Maximum count of the PIT.
+ */
+#define PIT_COUNT_MAX 0xffff
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Frequency divisor for one timer tick.
+ */
+static uint16_t divisor = 0;
+
+/**
+ * @brief Count programmed in one-shot mode.
+ */
+static uint16_t oneshot_count = 0;
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Programs the PIT.
+ *
+ * @param ctrl  Control byte.
+ * @param count Initial count.
+ */
+static void pit_program(uint8_t ctrl, uint16_t count)
+{
+    output8(PIT_CTRL, ctrl);
+    output8(PIT_DATA, (uint8_t)(count & 0xff));
+    output8(PIT_DATA, (uint8_t)((count >> 8)));
+}
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
@@ -44,15 +89,64 @@
  */
 void timer_init(unsigned freq)
 {
-    const uint16_t freq_divisor = PIT_FREQUENCY / freq;
+    divisor = PIT_FREQUENCY / freq;
 
     kprintf(MODULE_NAME " initializing timer...");
 
-    // Send control byte: adjust frequency divisor.
+    // Adjust frequency divisor.
     kprintf(MODULE_NAME " setting frequency to %d Hz", freq);
-    output8(PIT_CTRL, 0x36);
+    pit_program(PIT_PERIODIC, divisor);
+}
+
+/**
+ * @details Switches the timer device to periodic mode, so that it fires once
+ * every timer tick.
+ */
+void timer_periodic(void)
+{
+    oneshot_count = 0;
+    pit_program(PIT_PERIODIC, divisor);
+}
+
+/**
+ * @details Switches the timer device to one-shot mode, so that it fires only
+ * once, @p ticks timer ticks from now. The PIT counts at most 16 bits, thus
+ * the timer may be armed for fewer timer ticks than requested.
+ */
+unsigned timer_oneshot(unsigned ticks)
+{
+    const unsigned max_ticks = PIT_COUNT_MAX / divisor;
+
+    if (ticks > max_ticks) {
+        ticks = max_ticks;
+    }
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    oneshot_count = (uint16_t)(ticks * divisor);
+    pit_program(PIT_ONESHOT, oneshot_count);
+
+    return (ticks);
+}
+
+/**
+ * @details Gets the number of whole timer ticks elapsed since the timer device
+ * was armed in one-shot mode.
+ *
+ * @note The result is meaningful only if the timer device has not fired yet.
+ */
+unsigned timer_elapsed(void)
+{
+    output8(PIT_CTRL, PIT_LATCH);
+    const uint8_t lo = input8(PIT_DATA);
+    const uint8_t hi = input8(PIT_DATA);
+    const uint16_t count = (uint16_t)(((uint16_t)hi << 8) | lo);
+
+    // Counter already wrapped around.
+    if (count > oneshot_count) {
+        return (oneshot_count / divisor);
+    }
 
-    // Send data byte: divisor_low and divisor_high.
-    output8(PIT_DATA, (uint8_t)(freq_divisor & 0xff));
-    output8(PIT_DATA, (uint8_t)((freq_divisor >> 8)));
+    return ((oneshot_count - count) / divisor);
 }
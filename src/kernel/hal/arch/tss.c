@@ -8,6 +8,7 @@
  *============================================================================*/
 
 #include <nanvix/cc.h>
+#include <nanvix/kernel/config.h>
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 #include <nanvix/libcore.h>
@@ -17,9 +18,9 @@
  *============================================================================*/
 
 /**
- * @brief Task state segment (TSS).
+ * @brief Task state segments (TSS), one for each core.
  */
-struct tss tss;
+static struct tss tss[KERNEL_CORES_MAX];
 
 /*============================================================================*
  * Private Variables                                                          *
@@ -49,7 +50,28 @@ void tss_load(unsigned tss_selector)
 }
 
 /**
- * @details Initializes the Task State Segment (TSS).
+ * @details Gets the Task State Segment (TSS) of the underlying core.
+ */
+struct tss *tss_get(void)
+{
+    return (&tss[core_get_id()]);
+}
+
+/**
+ * @details Sets the ring 0 stack pointer in the Task State Segment (TSS) of
+ * the underlying core to @p esp0.
+ *
+ * @note This function is called from assembly code.
+ */
+void tss_set_esp0(word_t esp0)
+{
+    tss_get()->esp0 = esp0;
+}
+
+/**
+ * @details Initializes the Task State Segments (TSS) of all cores. The ring 0
+ * stack pointer of application cores is set once they switch to their first
+ * thread.
  */
 const struct tss *tss_init(unsigned ss0)
 {
@@ -58,12 +80,14 @@ const struct tss *tss_init(unsigned ss0)
     // Ensure that size of structures match what we expect.
     KASSERT_SIZE(sizeof(struct tss), TSS_SIZE);
 
-    // Blank TSS.
-    __memset(&tss, 0, TSS_SIZE);
+    // Blank TSSs.
+    __memset(tss, 0, sizeof(tss));
 
-    // Initialize the TSS.
-    tss.ss0 = ss0;
-    tss.esp0 = (word_t)kstack + PAGE_SIZE;
+    // Initialize the TSSs.
+    for (unsigned coreid = 0; coreid < KERNEL_CORES_MAX; coreid++) {
+        tss[coreid].ss0 = ss0;
+    }
+    tss[CORE_MASTER].esp0 = (word_t)kstack + PAGE_SIZE;
 
-    return (&tss);
+    return (tss);
 }
@@ -113,8 +113,12 @@ void do_exception(const struct exception *excp, const struct context *ctx)
         handler = default_handler;
     }
 
+    klock_acquire();
+
     /* Call handler. */
     handler(excp, ctx);
+
+    klock_release();
 }
 
 /**
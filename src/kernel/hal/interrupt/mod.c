@@ -32,6 +32,11 @@ static unsigned spurious = 0;
  */
 static uint64_t timer_value = 0;
 
+/**
+ * @brief Number of timer ticks for which the timer is armed in one-shot mode.
+ */
+static unsigned timer_oneshot_ticks = 0;
+
 /*============================================================================*
  * Private Functions                                                          *
  *============================================================================*/
@@ -54,7 +59,16 @@ static void default_handler(void)
  */
 static void do_timer(void)
 {
-    timer_value++;
+    // Account all timer ticks that were skipped in one-shot mode.
+    if (timer_oneshot_ticks != 0) {
+        timer_value += timer_oneshot_ticks;
+        timer_oneshot_ticks = 0;
+    } else {
+        timer_value++;
+    }
+
+    // Forward the timer tick to other cores.
+    cores_kick();
 
     // Check if we have a timer handler.
     if (LIKELY(timer_handler != NULL)) {
@@ -90,6 +104,44 @@ void interrupts_enable(void)
     lpic_enable();
 }
 
+/**
+ * @details Gets the number of timer interrupts.
+ */
+uint64_t interrupts_get_ticks(void)
+{
+    return (timer_value);
+}
+
+/**
+ * @details Stops the periodic timer tick and halts the underlying core until
+ * an interrupt is delivered. The timer is armed in one-shot mode to fire at
+ * most @p ticks timer ticks from now, and timer ticks that elapse meanwhile
+ * are still accounted. The periodic timer tick is resumed on return. If more
+ * than one core is online, the underlying core is halted without stopping the
+ * periodic timer tick.
+ */
+void interrupts_idle(unsigned ticks)
+{
+    // Other cores are ticked by the master core, thus the periodic timer tick
+    // is kept if more than one core is online.
+    if (cores_online() > 1) {
+        lpic_idle();
+        return;
+    }
+
+    timer_oneshot_ticks = timer_oneshot(ticks);
+
+    lpic_idle();
+
+    // Woken up by some other interrupt.
+    if (timer_oneshot_ticks != 0) {
+        timer_value += timer_elapsed();
+        timer_oneshot_ticks = 0;
+    }
+
+    timer_periodic();
+}
+
 /**
  * @details This function dispatches a hardware interrupt to the a
  * previously-registered handler function. If no handler function was
@@ -99,6 +151,8 @@ void interrupts_enable(void)
  */
 void do_interrupt(int intnum)
 {
+    klock_acquire();
+
     // Check if there are more pending interrupts to handle.
     do {
         // Acknowledge interrupt.
@@ -106,12 +160,34 @@ void do_interrupt(int intnum)
 
         // Check if there is a handler for this interrupt.
         if (UNLIKELY(interrupt_handlers[intnum] == NULL)) {
-            return;
+            break;
         }
 
         // Call handler.
         interrupt_handlers[intnum]();
     } while ((intnum = lpic_next()) != 0);
+
+    klock_release();
+}
+
+/**
+ * @details This function handles an inter-processor interrupt. These are sent
+ * by the master core on each timer tick, and to make other cores reschedule,
+ * thus the timer handler is called.
+ *
+ * @note This function is called from assembly code.
+ */
+void do_ipi(void)
+{
+    klock_acquire();
+
+    lapic_eoi();
+
+    if (LIKELY(timer_handler != NULL)) {
+        timer_handler();
+    }
+
+    klock_release();
 }
 
 /**
@@ -130,7 +206,8 @@ int interrupt_register(int num, interrupt_handler_t handler)
     // Check if target interrupt number concerns the timer.
     if (num != INTERRUPT_TIMER) {
         // It doesn't, check if we have a handler function already registered.
-        if (interrupt_handlers[num] != NULL) {
+        if ((interrupt_handlers[num] != NULL) &&
+            (interrupt_handlers[num] != default_handler)) {
             // We do, fail.
             kprintf(MODULE_NAME
                     " ERROR: interrupt handler already registered for irq %d",
@@ -174,7 +251,8 @@ int interrupt_unregister(int num)
     // Check if target interrupt number concerns the timer.
     if (num != INTERRUPT_TIMER) {
         // It doesn't, check if we have a handler function registered.
-        if (interrupt_handlers[num] == NULL) {
+        if ((interrupt_handlers[num] == NULL) ||
+            (interrupt_handlers[num] == default_handler)) {
             // We don't, fail.
             kprintf(MODULE_NAME
                     " ERROR: no interrupt handler registered for irq %d",
@@ -182,7 +260,7 @@ int interrupt_unregister(int num)
             return (-1);
         }
 
-        interrupt_handlers[num] = NULL;
+        interrupt_handlers[num] = default_handler;
     } else {
         // It does, check if we have a handler function registered.
         if (timer_handler == NULL) {
@@ -21,5 +21,6 @@ void hal_init(void)
     cpu_init();
     exceptions_init();
     interrupts_init();
+    stdout_async_init();
     mmu_init();
 }
@@ -321,16 +321,16 @@ int mailbox_push(const int mbxid, const void *msg, const size_t sz)
     // Update the tail.
     mbx->tail = (mbx->tail + 1) % MAILBOX_SIZE;
 
-    // Wake up blocked readers.
-    KASSERT(cond_broadcast(&mbx->readers) == 0);
+    // Wake up one blocked reader, which consumes the message.
+    KASSERT(cond_signal(&mbx->readers) == 0);
 
     return (0);
 }
 
 /**
- * Pop a message from a mailbox.
+ * Pop a message from a mailbox, waiting at most @p ticks timer ticks for one.
  */
-int mailbox_pop(const int mbxid, void *msg, const size_t sz)
+int mailbox_pop(const int mbxid, void *msg, const size_t sz, unsigned ticks)
 {
     // Ensure that the target mailbox is assigned.
     if (!mailbox_is_assigned(mbxid)) {
@@ -351,8 +351,13 @@ int mailbox_pop(const int mbxid, void *msg, const size_t sz)
     KASSERT(mbx != NULL);
 
     // Check if the mailbox is empty.
+    const uint64_t deadline = timeout_deadline(ticks);
     while (mbx->head == mbx->tail) {
-        cond_wait(&mbx->readers);
+        const int ret =
+            cond_wait_timeout(&mbx->readers, timeout_remaining(deadline));
+        if ((ret < 0) && (mbx->head == mbx->tail)) {
+            return (ret);
+        }
     }
 
     const struct message *_msg = &mbx->messages[mbx->head];
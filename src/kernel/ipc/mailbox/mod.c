@@ -37,11 +37,13 @@ extern int mailbox_push(const int mbxid, const void *msg, const size_t sz);
  * @param mbxid ID of the target mailbox.
  * @param msg Storage location for the message.
  * @param sz Size of the message.
+ * @param ticks Maximum number of timer ticks to wait for a message.
 
  * @return Upon successful completion, zero is returned. Upon failure, a
  * negative error code is returned instead.
  */
-extern int mailbox_pop(const int mbxid, void *msg, const size_t sz);
+extern int mailbox_pop(const int mbxid, void *msg, const size_t sz,
+                       unsigned ticks);
 
 /**
  * @brief Lookups a mailbox ID on the table of open mailboxes.
@@ -181,16 +183,20 @@ int do_mailbox_write(const int ombxid, const void *buffer, const size_t sz)
 }
 
 /**
- * @brief Reads a message from a mailbox.
+ * @brief Reads a message from a mailbox, with a timeout.
  *
  * @param ombxid ID of the target mailbox.
  * @param buffer Buffer where the data should be written to.
  * @param sz Number of bytes to read.
+ * @param ticks Maximum number of timer ticks to wait for a message, or
+ * TIMEOUT_INFINITE.
  *
- * @returns Upon successful completion, zero is returned. Upon failure, a
- * negative error code is returned instead.
+ * @returns Upon successful completion, zero is returned. If no message arrives
+ * in time, -ETIMEDOUT is returned. Upon failure, a negative error code is
+ * returned instead.
  */
-int do_mailbox_read(const int ombxid, void *buffer, const size_t sz)
+int do_mailbox_read_timeout(const int ombxid, void *buffer, const size_t sz,
+                            unsigned ticks)
 {
     // Lookup target mailbox.
     const int mbxid = omailboxes_lookup(ombxid);
@@ -218,7 +224,22 @@ int do_mailbox_read(const int ombxid, void *buffer, const size_t sz)
 
     // TODO: pin user memory.
 
-    return (mailbox_pop(mbxid, buffer, sz));
+    return (mailbox_pop(mbxid, buffer, sz, ticks));
+}
+
+/**
+ * @brief Reads a message from a mailbox.
+ *
+ * @param ombxid ID of the target mailbox.
+ * @param buffer Buffer where the data should be written to.
+ * @param sz Number of bytes to read.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+int do_mailbox_read(const int ombxid, void *buffer, const size_t sz)
+{
+    return (do_mailbox_read_timeout(ombxid, buffer, sz, TIMEOUT_INFINITE));
 }
 
 /**
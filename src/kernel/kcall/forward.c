@@ -0,0 +1,245 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/errno.h>
+#include <nanvix/kernel/config.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/pm.h>
+#include <stdnoreturn.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Number of forwarding slots.
+ *
+ * @note This should be a power of two.
+ */
+#define KCALL_FORWARD_SLOTS 16
+
+/**
+ * @name States of a Forwarding Slot
+ */
+/**@{*/
+#define KCALL_FORWARD_FREE 0    /** Free.                    */
+#define KCALL_FORWARD_PENDING 1 /** Waiting for a handler.   */
+#define KCALL_FORWARD_SERVING 2 /** Being served.            */
+#define KCALL_FORWARD_DONE 3    /** Waiting for its caller.  */
+/**@}*/
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Forwarding slot.
+ */
+struct kcall_forward_slot {
+    int state;           /** State.                       */
+    tid_t caller;        /** Calling thread.              */
+    word_t kcall_nr;     /** Kernel call number.          */
+    word_t args[5];      /** Arguments of kernel call.    */
+    int ret;             /** Return value of kernel call. */
+    struct condvar done; /** Caller waiting for the slot. */
+};
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Forwarding slots.
+ */
+static struct kcall_forward_slot slots[KCALL_FORWARD_SLOTS];
+
+/**
+ * @brief Queue of pending forwarding slots, in arrival order.
+ */
+static struct {
+    unsigned head;                       /** Next slot to serve.  */
+    unsigned tail;                       /** Next free position.  */
+    unsigned slots[KCALL_FORWARD_SLOTS]; /** Indexes of slots.    */
+} pending_queue;
+
+/**
+ * @brief Number of free forwarding slots.
+ */
+static struct semaphore free_slots =
+    SEMAPHORE_INITIALIZER(KCALL_FORWARD_SLOTS);
+
+/**
+ * @brief Number of pending forwarding slots.
+ */
+static struct semaphore pending_slots = SEMAPHORE_INITIALIZER(0);
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Releases a forwarding slot.
+ *
+ * @param slot Target forwarding slot.
+ */
+static void slot_free(struct kcall_forward_slot *slot)
+{
+    KASSERT(slot->state == KCALL_FORWARD_DONE);
+
+    slot->state = KCALL_FORWARD_FREE;
+    semaphore_up(&free_slots);
+}
+
+/**
+ * @brief Checks if the caller of a forwarding slot was released.
+ *
+ * @details A caller waits in the queue of its slot until it picks up the
+ * return value, and a thread that is released leaves the queue that it waits
+ * on. A caller that is running holds the kernel lock, thus it is never seen
+ * out of the queue.
+ *
+ * @param slot Target forwarding slot.
+ *
+ * @returns True if the caller of @p slot was released, and false otherwise.
+ */
+static bool slot_orphaned(const struct kcall_forward_slot *slot)
+{
+    return (slot->done.head == NULL);
+}
+
+/**
+ * @brief Releases forwarding slots that were served after their callers were
+ * released.
+ */
+static void slot_reap(void)
+{
+    for (int i = 0; i < KCALL_FORWARD_SLOTS; i++) {
+        if ((slots[i].state == KCALL_FORWARD_DONE) &&
+            slot_orphaned(&slots[i])) {
+            slot_free(&slots[i]);
+        }
+    }
+}
+
+/**
+ * @brief Allocates a forwarding slot.
+ *
+ * @returns A pointer to the allocated forwarding slot.
+ *
+ * @note The calling thread blocks until a forwarding slot is available.
+ */
+static struct kcall_forward_slot *slot_alloc(void)
+{
+    slot_reap();
+    semaphore_down(&free_slots);
+
+    for (int i = 0; i < KCALL_FORWARD_SLOTS; i++) {
+        if (slots[i].state == KCALL_FORWARD_FREE) {
+            slots[i].state = KCALL_FORWARD_PENDING;
+            return (&slots[i]);
+        }
+    }
+
+    // The semaphore accounts for every free slot.
+    UNREACHABLE();
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Forwards the kernel call @p kcall_nr to a handler thread and blocks
+ * the calling thread until the kernel call is served. Other threads may keep
+ * running and forward their own kernel calls meanwhile.
+ */
+int kcall_forward(word_t kcall_nr, word_t arg0, word_t arg1, word_t arg2,
+                  word_t arg3, word_t arg4)
+{
+    struct kcall_forward_slot *slot = slot_alloc();
+
+    // Copy kernel call parameters.
+    slot->caller = thread_get_curr();
+    slot->kcall_nr = kcall_nr;
+    slot->args[0] = arg0;
+    slot->args[1] = arg1;
+    slot->args[2] = arg2;
+    slot->args[3] = arg3;
+    slot->args[4] = arg4;
+    slot->ret = -ENOSYS;
+
+    // Enqueue slot and notify handlers.
+    pending_queue.slots[pending_queue.tail++ & (KCALL_FORWARD_SLOTS - 1)] =
+        (unsigned)(slot - slots);
+    semaphore_up(&pending_slots);
+
+    // Wait for completion. Only the calling thread is put to sleep.
+    while (slot->state != KCALL_FORWARD_DONE) {
+        cond_wait(&slot->done);
+    }
+
+    const int ret = slot->ret;
+    slot_free(slot);
+
+    return (ret);
+}
+
+/**
+ * @details Serves the oldest pending forwarded kernel call and wakes up its
+ * caller. This function may be called concurrently by several handler
+ * threads: each one takes a different slot from the queue of pending slots.
+ * If the caller was released meanwhile, the slot is released instead.
+ */
+void kcall_forward_serve(void)
+{
+    semaphore_down(&pending_slots);
+
+    const unsigned index =
+        pending_queue.slots[pending_queue.head++ & (KCALL_FORWARD_SLOTS - 1)];
+    struct kcall_forward_slot *slot = &slots[index];
+    KASSERT(slot->state == KCALL_FORWARD_PENDING);
+    slot->state = KCALL_FORWARD_SERVING;
+
+    // No handler is registered for forwarded kernel calls yet, thus the return
+    // value set by the caller is left untouched.
+
+    slot->state = KCALL_FORWARD_DONE;
+    if (slot_orphaned(slot)) {
+        slot_free(slot);
+        return;
+    }
+
+    // The caller leaves the queue of the slot once it runs.
+    thread_wakeup(slot->done.head->tid);
+}
+
+/**
+ * @details Handles forwarded kernel calls. This is the main loop of handler
+ * threads, and it does not return.
+ */
+noreturn void handle_syscall(void)
+{
+    while (true) {
+        kcall_forward_serve();
+    }
+}
+
+/**
+ * @details Starts the pool of handler threads. The calling thread is expected
+ * to serve forwarded kernel calls as well, thus KERNEL_KCALL_HANDLERS - 1
+ * kernel threads are created.
+ */
+void kcall_handlers_start(void)
+{
+    for (int i = 1; i < KERNEL_KCALL_HANDLERS; i++) {
+        KASSERT(thread_create_kernel(handle_syscall) >= 0);
+    }
+}
@@ -15,57 +15,30 @@
 #include <nanvix/kernel/pm.h>
 #include <stdnoreturn.h>
 
-/*============================================================================*
- * Private Variables                                                          *
- *============================================================================*/
-
-static struct semaphore kernel_semahore = SEMAPHORE_INITIALIZER(0);
-static struct semaphore user_semaphore = SEMAPHORE_INITIALIZER(0);
-
-static volatile struct {
-    word_t kcall_nr; /** Kernel call number.             */
-    word_t arg0;     /** First argument of kernel call.  */
-    word_t arg1;     /** Second argument of kernel call. */
-    word_t arg2;     /** Third argument of kernel call.  */
-    word_t arg3;     /** Fourth argument of kernel call. */
-    word_t arg4;     /** Fifth argument of kernel call.  */
-    word_t ret;      /** Return value of kernel call.    */
-} scoreboard;
-
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
 
-noreturn void handle_syscall(void)
-{
-
-    while (true) {
-        semaphore_down(&kernel_semahore);
-
-        semaphore_up(&user_semaphore);
-    }
-}
-
 /**
- * @brief Kernel call dispatcher.
- *
- * @param arg0     First kernel call argument.
- * @param arg1     Second kernel call argument.
- * @param arg2     Third kernel call argument.
- * @param arg3     Fourth kernel call argument.
- * @param arg4     Fifth kernel call argument.
- * @param kcall_nr Kernel call number.
- *
- * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * @details Dispatches a kernel call to its handler. Kernel calls run under the
+ * kernel lock, and a calling thread that was released by another core while
+ * waiting for it never gets dispatched.
  */
 int do_kcall(word_t arg0, word_t arg1, word_t arg2, word_t arg3, word_t arg4,
              word_t kcall_nr)
 {
     int ret = -1;
 
+    klock_acquire();
+    thread_check_killed();
+    thread_kcall_enter();
+
+    const uint64_t start = cpu_cycles();
+
     KASSERT_SIZE_LE(sizeof(unsigned), sizeof(void *));
 
+    kcall_stats_enter(kcall_nr);
+
     switch (kcall_nr) {
         case NR_void0:
             ret = kcall_void0();
@@ -137,14 +110,17 @@ int do_kcall(word_t arg0, word_t arg1, word_t arg2, word_t arg3, word_t arg4,
             ret = kcall_thread_get_id();
             break;
         case NR_thread_create:
-            ret = kcall_thread_create(
-                (void (*)())arg0, (void *)arg1, (void (*)(void))arg2);
+            ret = kcall_thread_create((void (*)())arg0,
+                                      (void *)arg1,
+                                      (void (*)(void))arg2,
+                                      (size_t)arg3);
             break;
         case NR_thread_exit:
             kcall_thread_exit((void *)arg0);
             break;
         case NR_thread_yield:
             kcall_thread_yield();
+            ret = 0;
             break;
         case NR_mailbox_tag:
             ret = kcall_mailbox_tag((int)arg0);
@@ -155,19 +131,75 @@ int do_kcall(word_t arg0, word_t arg1, word_t arg2, word_t arg3, word_t arg4,
         case NR_thread_detach:
             ret = kcall_thread_detach((tid_t)arg0);
             break;
+        case NR_kcall_submit:
+            ret = kcall_submit((struct kcall_ring *)arg0, (unsigned)arg1);
+            break;
+        case NR_stats:
+            ret = kcall_stats((struct kcall_stats *)arg0, (unsigned)arg1);
+            break;
+        case NR_thread_setprio:
+            ret = kcall_thread_setprio((tid_t)arg0, (int)arg1);
+            break;
+        case NR_thread_getprio:
+            ret = kcall_thread_getprio((tid_t)arg0);
+            break;
+        case NR_thread_setquantum:
+            ret = kcall_thread_setquantum((tid_t)arg0, (unsigned)arg1);
+            break;
+        case NR_thread_getquantum:
+            ret = kcall_thread_getquantum((tid_t)arg0,
+                                          (struct thread_quantum *)arg1);
+            break;
+        case NR_thread_yield_to:
+            ret = kcall_thread_yield_to((tid_t)arg0);
+            break;
+        case NR_thread_stats:
+            ret = kcall_thread_stats((tid_t)arg0, (struct thread_stats *)arg1);
+            break;
+        case NR_process_stats:
+            ret =
+                kcall_process_stats((pid_t)arg0, (struct thread_stats *)arg1);
+            break;
+        case NR_sleep:
+            ret = kcall_sleep((unsigned)arg0);
+            break;
+        case NR_thread_join_timeout:
+            ret = kcall_thread_join_timeout(
+                (tid_t)arg0, (void **)arg1, (unsigned)arg2);
+            break;
+        case NR_thread_setrt:
+            ret = kcall_thread_setrt((tid_t)arg0,
+                                     (const struct thread_rt *)arg1);
+            break;
+        case NR_thread_getrt:
+            ret = kcall_thread_getrt((tid_t)arg0, (struct thread_rt *)arg1);
+            break;
+        case NR_sched_affinity:
+            ret = kcall_sched_affinity((unsigned)arg0);
+            break;
+        case NR_thread_settls:
+            ret = kcall_thread_settls((void *)arg0);
+            break;
+        case NR_process_setshare:
+            ret = kcall_process_setshare((pid_t)arg0,
+                                         (const struct thread_share *)arg1);
+            break;
+        case NR_process_getshare:
+            ret = kcall_process_getshare((pid_t)arg0,
+                                         (struct thread_share *)arg1);
+            break;
+        case NR_process_get_id:
+            ret = kcall_process_get_id();
+            break;
         default:
-            // Copy kernel call parameters.
-            scoreboard.kcall_nr = kcall_nr;
-            scoreboard.arg0 = arg0;
-            scoreboard.arg1 = arg1;
-            scoreboard.arg2 = arg2;
-            scoreboard.arg3 = arg3;
-            scoreboard.arg4 = arg4;
-
-            semaphore_up(&kernel_semahore);
-            semaphore_down(&user_semaphore);
+            ret = kcall_forward(kcall_nr, arg0, arg1, arg2, arg3, arg4);
             break;
     };
 
+    kcall_stats_leave(kcall_nr, ret, cpu_cycles() - start);
+
+    thread_kcall_leave();
+    klock_release();
+
     return (ret);
 }
@@ -10,6 +10,7 @@
  * Imports                                                                    *
  *============================================================================*/
 
+#include <nanvix/kernel/kcall.h>
 #include <nanvix/kernel/kmod.h>
 #include <nanvix/kernel/mm.h>
 #include <nanvix/kernel/pm.h>
@@ -258,19 +259,27 @@ extern int kcall_semctl(int id, int cmd, int val);
  */
 extern tid_t kcall_thread_get_id(void);
 
+/**
+ * @brief Gets the ID of the calling process.
+ *
+ * @returns The ID of the calling process is returned.
+ */
+extern pid_t kcall_process_get_id(void);
+
 /**
  * @brief Creates a new thread.
  *
  * @param start Start routine.
  * @param args Arguments.
  *@param caller Thread caller function.
+ * @param stacksize Size of the user stack (in bytes).
  *
  * @returns Upon successful completion, the ID of the newly created
  * thread is returned. Upon failure, a negative error code is
  * returned instead.
  */
 extern tid_t kcall_thread_create(void (*start)(void *), void *args,
-                                 void (*caller)());
+                                 void (*caller)(), size_t stacksize);
 
 /**
  * @brief Exits the calling thread.
@@ -281,11 +290,18 @@ extern noreturn void kcall_thread_exit(void *retval);
 
 /**
  * @brief Yields the processor to another thread.
+ */
+extern void kcall_thread_yield(void);
+
+/**
+ * @brief Yields the processor to a target thread.
  *
- * @returns Upon successful completion, zero is returned. Upon failure,
- * a negative error code is returned instead.
+ * @param tid ID of the target thread.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
  */
-extern noreturn void kcall_thread_yield(void);
+extern int kcall_thread_yield_to(tid_t tid);
 
 /**
  * @brief Waits for the target thread to terminate.
@@ -298,6 +314,19 @@ extern noreturn void kcall_thread_yield(void);
  */
 extern int kcall_thread_join(tid_t tid, void **retval);
 
+/**
+ * @brief Waits for the target thread to terminate, with a timeout.
+ *
+ * @param tid    ID of the target thread.
+ * @param retval Location to store the return value of the target thread.
+ * @param ticks  Maximum number of timer ticks to wait, or TIMEOUT_INFINITE.
+ *
+ * @returns Upon successful completion, zero is returned. If the target thread
+ * does not terminate in time, -ETIMEDOUT is returned. Upon failure, a negative
+ * error code is returned instead.
+ */
+extern int kcall_thread_join_timeout(tid_t tid, void **retval, unsigned ticks);
+
 /**
  * @brief Detaches the target thread.
  *
@@ -308,6 +337,226 @@ extern int kcall_thread_join(tid_t tid, void **retval);
  */
 extern int kcall_thread_detach(tid_t tid);
 
+/**
+ * @brief Sets the priority of a thread.
+ *
+ * @param tid  ID of the target thread.
+ * @param prio New priority.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_setprio(tid_t tid, int prio);
+
+/**
+ * @brief Gets the priority of a thread.
+ *
+ * @param tid ID of the target thread.
+ *
+ * @returns Upon successful completion, the priority of the target thread is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern int kcall_thread_getprio(tid_t tid);
+
+/**
+ * @brief Sets the quantum of a thread.
+ *
+ * @param tid     ID of the target thread.
+ * @param quantum New quantum (in timer ticks), or THREAD_QUANTUM_ADAPTIVE.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_setquantum(tid_t tid, unsigned quantum);
+
+/**
+ * @brief Gets quantum information of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for quantum information.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_getquantum(tid_t tid, struct thread_quantum *buf);
+
+/**
+ * @brief Sets the real-time parameters of a thread.
+ *
+ * @param tid    ID of the target thread.
+ * @param params New real-time parameters.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_setrt(tid_t tid, const struct thread_rt *params);
+
+/**
+ * @brief Gets the real-time parameters of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for real-time parameters.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_getrt(tid_t tid, struct thread_rt *buf);
+
+/**
+ * @brief Sets the bound of address space affinity of the scheduler.
+ *
+ * @param bound New bound, or zero to turn address space affinity off.
+ *
+ * @returns Upon successful completion, the previous bound is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int kcall_sched_affinity(unsigned bound);
+
+/**
+ * @brief Sets the TLS base address of the calling thread.
+ *
+ * @param base Base address of the TLS segment, or NULL to clear it.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_settls(void *base);
+
+/**
+ * @brief Gets statistics of a thread.
+ *
+ * @param tid ID of the target thread.
+ * @param buf Storage location for thread statistics.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_thread_stats(tid_t tid, struct thread_stats *buf);
+
+/**
+ * @brief Gets statistics of a process.
+ *
+ * @param pid ID of the target process.
+ * @param buf Storage location for process statistics.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_process_stats(pid_t pid, struct thread_stats *buf);
+
+/**
+ * @brief Sets the fair share parameters of a process.
+ *
+ * @param pid    ID of the target process.
+ * @param params New fair share parameters.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_process_setshare(pid_t pid,
+                                  const struct thread_share *params);
+
+/**
+ * @brief Gets the fair share parameters of a process.
+ *
+ * @param pid ID of the target process.
+ * @param buf Storage location for fair share parameters.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure, a
+ * negative error code is returned instead.
+ */
+extern int kcall_process_getshare(pid_t pid, struct thread_share *buf);
+
+/**
+ * @brief Puts the calling thread to sleep for a number of timer ticks.
+ *
+ * @param ticks Number of timer ticks to sleep.
+ *
+ * @returns Zero is always returned.
+ */
+extern int kcall_sleep(unsigned ticks);
+
+/**
+ * @brief Submits a batch of kernel calls.
+ *
+ * @param ring Target kernel call ring.
+ * @param n    Maximum number of kernel calls to submit.
+ *
+ * @returns Upon successful completion, the number of kernel calls that were
+ * consumed from the submission queue is returned. Upon failure, a negative
+ * error code is returned instead.
+ */
+extern int kcall_submit(struct kcall_ring *ring, unsigned n);
+
+/**
+ * @brief Gets kernel call statistics.
+ *
+ * @param buf Storage location for kernel call statistics.
+ * @param n   Number of entries in @p buf.
+ *
+ * @returns Upon successful completion, the number of entries copied to @p buf
+ * is returned. If @p buf is NULL and @p n is zero, the number of kernel calls
+ * is returned. Upon failure, a negative error code is returned instead.
+ */
+extern int kcall_stats(struct kcall_stats *buf, unsigned n);
+
+/**
+ * @brief Accounts the invocation of a kernel call.
+ *
+ * @param kcall_nr Kernel call number.
+ */
+extern void kcall_stats_enter(word_t kcall_nr);
+
+/**
+ * @brief Accounts the completion of a kernel call.
+ *
+ * @param kcall_nr Kernel call number.
+ * @param ret      Return value of the kernel call.
+ * @param cycles   Latency of the kernel call (in cycles).
+ */
+extern void kcall_stats_leave(word_t kcall_nr, int ret, uint64_t cycles);
+
+/**
+ * @brief Forwards a kernel call to a handler thread.
+ *
+ * @param kcall_nr Kernel call number.
+ * @param arg0     First kernel call argument.
+ * @param arg1     Second kernel call argument.
+ * @param arg2     Third kernel call argument.
+ * @param arg3     Fourth kernel call argument.
+ * @param arg4     Fifth kernel call argument.
+ *
+ * @returns The return value of the forwarded kernel call.
+ */
+extern int kcall_forward(word_t kcall_nr, word_t arg0, word_t arg1,
+                         word_t arg2, word_t arg3, word_t arg4);
+
+/**
+ * @brief Serves a forwarded kernel call.
+ */
+extern void kcall_forward_serve(void);
+
+/**
+ * @brief Starts the pool of threads that serve forwarded kernel calls.
+ */
+extern void kcall_handlers_start(void);
+
+/**
+ * @brief Kernel call dispatcher.
+ *
+ * @param arg0     First kernel call argument.
+ * @param arg1     Second kernel call argument.
+ * @param arg2     Third kernel call argument.
+ * @param arg3     Fourth kernel call argument.
+ * @param arg4     Fifth kernel call argument.
+ * @param kcall_nr Kernel call number.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int do_kcall(word_t arg0, word_t arg1, word_t arg2, word_t arg3,
+                    word_t arg4, word_t kcall_nr);
+
 /*============================================================================*/
 
 #endif /* KERNEL_KCALL_MOD_H_ */
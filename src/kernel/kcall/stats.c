@@ -0,0 +1,116 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/errno.h>
+#include <nanvix/kernel/kcall.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm.h>
+#include <nanvix/libcore.h>
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Kernel call statistics.
+ */
+static struct kcall_stats stats[NR_SYSCALLS];
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Computes the latency histogram bucket for a number of cycles.
+ *
+ * @param cycles Number of cycles.
+ *
+ * @returns The histogram bucket for @p cycles.
+ */
+static unsigned latency_bucket(uint64_t cycles)
+{
+    const uint32_t lo = (uint32_t)cycles;
+
+    // Saturate long latencies in the last bucket.
+    if ((cycles >> 32) != 0) {
+        return (KCALL_STATS_BUCKETS - 1);
+    }
+
+    // Bucket zero also holds zero-cycle samples.
+    if (lo == 0) {
+        return (0);
+    }
+
+    const unsigned bucket = (WORD_BIT - 1) - __builtin_clz(lo);
+
+    return ((bucket < KCALL_STATS_BUCKETS) ? bucket
+                                           : (KCALL_STATS_BUCKETS - 1));
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Accounts an invocation of the kernel call @p kcall_nr.
+ */
+void kcall_stats_enter(word_t kcall_nr)
+{
+    if (kcall_nr < NR_SYSCALLS) {
+        stats[kcall_nr].count++;
+    }
+}
+
+/**
+ * @details Accounts the completion of the kernel call @p kcall_nr, which
+ * returned @p ret after @p cycles cycles.
+ */
+void kcall_stats_leave(word_t kcall_nr, int ret, uint64_t cycles)
+{
+    if (kcall_nr < NR_SYSCALLS) {
+        if (ret < 0) {
+            stats[kcall_nr].errors++;
+        }
+        stats[kcall_nr].latency[latency_bucket(cycles)]++;
+    }
+}
+
+/**
+ * @details Copies a snapshot of the statistics of at most @p n kernel calls,
+ * indexed by kernel call number, to the buffer pointed to by @p buf. If @p buf
+ * is NULL and @p n is zero, nothing is copied, and the number of kernel calls
+ * is returned instead.
+ */
+int kcall_stats(struct kcall_stats *buf, unsigned n)
+{
+    // Report the number of kernel calls.
+    if ((buf == NULL) && (n == 0)) {
+        return (NR_SYSCALLS);
+    }
+
+    // Check for invalid buffer.
+    if (buf == NULL) {
+        return (-EINVAL);
+    }
+
+    // Copy at most as many entries as there are kernel calls.
+    if (n > NR_SYSCALLS) {
+        n = NR_SYSCALLS;
+    }
+
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), n * sizeof(struct kcall_stats), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    __memcpy(buf, stats, n * sizeof(struct kcall_stats));
+
+    return (n);
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/errno.h>
+#include <nanvix/kernel/kcall.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm.h>
+#include <nanvix/kernel/pm.h>
+#include <nanvix/libcore.h>
+#include <stdbool.h>
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether a kernel call may be issued from a batch.
+ *
+ * @details Kernel calls that do not return, or that may switch the calling
+ * thread out while the kernel call ring is in use, are not issued from a batch.
+ *
+ * @param kcall_nr Kernel call number.
+ *
+ * @returns If the target kernel call may be issued from a batch, true is
+ * returned. Otherwise, false is returned instead.
+ */
+static bool kcall_is_batchable(word_t kcall_nr)
+{
+    switch (kcall_nr) {
+        // Kernel calls that do not return.
+        case NR_shutdown:
+        case NR_thread_exit:
+        // Nested batches.
+        case NR_kcall_submit:
+        // Kernel calls that may block or yield.
+        case NR_semop:
+        case NR_thread_yield:
+        case NR_thread_yield_to:
+        case NR_thread_join:
+        case NR_thread_join_timeout:
+        case NR_sleep:
+            return (false);
+        default:
+            return (kcall_nr < NR_SYSCALLS);
+    }
+}
+
+/**
+ * @brief Asserts whether a kernel call ring is mapped.
+ *
+ * @details Kernel calls issued from a batch may change the address space of
+ * the calling process, thus pages of the kernel call ring are looked up in the
+ * page directory of the calling process before the ring is written.
+ *
+ * @param ring Target kernel call ring.
+ *
+ * @returns If all pages of the target kernel call ring are mapped, true is
+ * returned. Otherwise, false is returned instead.
+ */
+static bool kcall_ring_is_mapped(const struct kcall_ring *ring)
+{
+    struct pageinfo pageinfo;
+    const vaddr_t end = VADDR(ring) + sizeof(struct kcall_ring);
+    struct pde *pgdir =
+        (struct pde *)vmem_pgdir_get(process_get_curr()->vmem);
+
+    for (vaddr_t vaddr = ALIGN(VADDR(ring), PAGE_SIZE); vaddr < end;
+         vaddr += PAGE_SIZE) {
+        if (upage_info(pgdir, vaddr, &pageinfo) != 0) {
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Consumes at most @p n entries from the submission queue of the
+ * kernel call ring pointed to by @p ring, issues the corresponding kernel
+ * calls in order, and posts their return values in the completion queue.
+ * Consumption stops early if the submission queue runs empty or if the
+ * completion queue fills up. If an issued kernel call unmaps the kernel call
+ * ring, the batch is aborted and its completion is lost.
+ */
+int kcall_submit(struct kcall_ring *ring, unsigned n)
+{
+    int count = 0;
+
+    // Check for invalid ring.
+    if (ring == NULL) {
+        return (-EINVAL);
+    }
+
+    // Check for invalid ring location.
+    if (!mm_check_area(VADDR(ring), sizeof(struct kcall_ring), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    // Check for unmapped ring.
+    if (!kcall_ring_is_mapped(ring)) {
+        return (-EFAULT);
+    }
+
+    // Check for corrupted submission queue.
+    if ((ring->sq_tail - ring->sq_head) > KCALL_RING_LENGTH) {
+        return (-EINVAL);
+    }
+
+    while ((unsigned)count < n) {
+        int ret = -ENOTSUP;
+        struct kcall_sqe sqe;
+        struct kcall_cqe *cqe = NULL;
+        const uint32_t sq_head = ring->sq_head;
+        const uint32_t cq_tail = ring->cq_tail;
+
+        // Submission queue is empty.
+        if (sq_head == ring->sq_tail) {
+            break;
+        }
+
+        // Completion queue is full.
+        if ((cq_tail - ring->cq_head) >= KCALL_RING_LENGTH) {
+            break;
+        }
+
+        // Copy submission entry, so that user code cannot change it meanwhile.
+        __memcpy(&sqe,
+                 &ring->sq[sq_head & (KCALL_RING_LENGTH - 1)],
+                 sizeof(struct kcall_sqe));
+        ring->sq_head = sq_head + 1;
+
+        if (kcall_is_batchable(sqe.kcall_nr)) {
+            ret = do_kcall(sqe.args[0],
+                           sqe.args[1],
+                           sqe.args[2],
+                           sqe.args[3],
+                           sqe.args[4],
+                           sqe.kcall_nr);
+        }
+
+        // Check if the kernel call has unmapped the ring.
+        if (!kcall_ring_is_mapped(ring)) {
+            return (-EFAULT);
+        }
+
+        cqe = &ring->cq[cq_tail & (KCALL_RING_LENGTH - 1)];
+        cqe->tag = sqe.tag;
+        cqe->ret = ret;
+        ring->cq_tail = cq_tail + 1;
+
+        count++;
+    }
+
+    return (count);
+}
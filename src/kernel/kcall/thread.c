@@ -8,6 +8,7 @@
  *============================================================================*/
 
 #include <nanvix/errno.h>
+#include <nanvix/kernel/mm.h>
 #include <nanvix/kernel/pm.h>
 #include <stdnoreturn.h>
 
@@ -18,11 +19,12 @@
 /**
  * @details Creates a new thread.
  */
-tid_t kcall_thread_create(void *(*start)(), void *args, void (*caller)())
+tid_t kcall_thread_create(void *(*start)(), void *args, void (*caller)(),
+                          size_t stacksize)
 {
     KASSERT((word_t)start > USER_BASE_VIRT && (word_t)start < USER_END_VIRT);
     KASSERT((word_t)caller > USER_BASE_VIRT && (word_t)caller < USER_END_VIRT);
-    return (thread_create(process_get_curr(), start, args, caller));
+    return (thread_create(process_get_curr(), start, args, caller, stacksize));
 }
 
 /**
@@ -42,6 +44,15 @@ void kcall_thread_yield(void)
     thread_yield();
 }
 
+/**
+ * @details Yields the processor to the thread whose ID is @p tid, donating to
+ * it the remainder of the time slice of the calling thread.
+ */
+int kcall_thread_yield_to(tid_t tid)
+{
+    return (thread_yield_to(tid));
+}
+
 /**
  * @details Returns the ID of the calling thread.
  */
@@ -50,6 +61,14 @@ tid_t kcall_thread_get_id(void)
     return (thread_get_curr());
 }
 
+/**
+ * @details Returns the ID of the calling process.
+ */
+pid_t kcall_process_get_id(void)
+{
+    return (thread_get_pid(thread_get_curr()));
+}
+
 /**
  * @details Waits for a thread to terminate.
  */
@@ -58,6 +77,14 @@ int kcall_thread_join(tid_t tid, void **retval)
     return (thread_join(tid, retval));
 }
 
+/**
+ * @details Waits for a thread to terminate, for at most @p ticks timer ticks.
+ */
+int kcall_thread_join_timeout(tid_t tid, void **retval, unsigned ticks)
+{
+    return (thread_join_timeout(tid, retval, ticks));
+}
+
 /**
  * @details Detaches a thread.
  */
@@ -65,3 +92,157 @@ int kcall_thread_detach(tid_t tid)
 {
     return (thread_detach(tid));
 }
+
+/**
+ * @details Sets the priority of a thread.
+ */
+int kcall_thread_setprio(tid_t tid, int prio)
+{
+    return (thread_setprio(tid, prio));
+}
+
+/**
+ * @details Gets the priority of a thread.
+ */
+int kcall_thread_getprio(tid_t tid)
+{
+    return (thread_getprio(tid));
+}
+
+/**
+ * @details Sets the quantum of a thread.
+ */
+int kcall_thread_setquantum(tid_t tid, unsigned quantum)
+{
+    return (thread_setquantum(tid, quantum));
+}
+
+/**
+ * @details Gets quantum information of a thread.
+ */
+int kcall_thread_getquantum(tid_t tid, struct thread_quantum *buf)
+{
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), sizeof(struct thread_quantum), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_getquantum(tid, buf));
+}
+
+/**
+ * @details Sets the real-time parameters of a thread.
+ */
+int kcall_thread_setrt(tid_t tid, const struct thread_rt *params)
+{
+    struct thread_rt rt;
+
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(params), sizeof(struct thread_rt), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    __memcpy(&rt, params, sizeof(struct thread_rt));
+
+    return (thread_setrt(tid, &rt));
+}
+
+/**
+ * @details Gets the real-time parameters of a thread.
+ */
+int kcall_thread_getrt(tid_t tid, struct thread_rt *buf)
+{
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), sizeof(struct thread_rt), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_getrt(tid, buf));
+}
+
+/**
+ * @details Sets the bound of address space affinity of the scheduler.
+ */
+int kcall_sched_affinity(unsigned bound)
+{
+    return (thread_set_affinity(bound));
+}
+
+/**
+ * @details Sets the TLS base address of the calling thread.
+ */
+int kcall_thread_settls(void *base)
+{
+    // Check for invalid TLS location.
+    if ((base != NULL) && !mm_check_area(VADDR(base), WORD_SIZE, UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_set_tls((word_t)base));
+}
+
+/**
+ * @details Gets statistics of a thread.
+ */
+int kcall_thread_stats(tid_t tid, struct thread_stats *buf)
+{
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), sizeof(struct thread_stats), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_getstats(tid, buf));
+}
+
+/**
+ * @details Gets statistics of a process.
+ */
+int kcall_process_stats(pid_t pid, struct thread_stats *buf)
+{
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), sizeof(struct thread_stats), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_getstats_all(pid, buf));
+}
+
+/**
+ * @details Sets the fair share parameters of a process.
+ */
+int kcall_process_setshare(pid_t pid, const struct thread_share *params)
+{
+    struct thread_share share;
+
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(params), sizeof(struct thread_share), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    __memcpy(&share, params, sizeof(struct thread_share));
+
+    return (thread_setshare(pid, &share));
+}
+
+/**
+ * @details Gets the fair share parameters of a process.
+ */
+int kcall_process_getshare(pid_t pid, struct thread_share *buf)
+{
+    // Check for invalid buffer location.
+    if (!mm_check_area(VADDR(buf), sizeof(struct thread_share), UMEM_AREA)) {
+        return (-EFAULT);
+    }
+
+    return (thread_getshare(pid, buf));
+}
+
+/**
+ * @details Puts the calling thread to sleep for @p ticks timer ticks.
+ */
+int kcall_sleep(unsigned ticks)
+{
+    thread_sleep_ticks(ticks);
+
+    return (0);
+}
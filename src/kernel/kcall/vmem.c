@@ -55,6 +55,11 @@ int kcall_vmmap(vmem_t vmem, vaddr_t vaddr, frame_t frame)
         return (-1);
     }
 
+    // Check for kernel information page.
+    if (ALIGN(vaddr, PAGE_SIZE) == KINFO_BASE_VIRT) {
+        return (-1);
+    }
+
     // Issue underlying operation.
     int ret = vmem_map(vmem, vaddr, frame, PAGE_SIZE, false, false);
 
@@ -71,6 +76,11 @@ frame_t kcall_vmunmap(vmem_t vmem, vaddr_t vaddr)
         return (-1);
     }
 
+    // Check for kernel information page.
+    if (ALIGN(vaddr, PAGE_SIZE) == KINFO_BASE_VIRT) {
+        return (-1);
+    }
+
     // Issue underlying operation.
     frame_t frame = vmem_unmap(vmem, vaddr);
 
@@ -86,6 +96,11 @@ int kcall_vmctrl(vmem_t vmem, unsigned request, vaddr_t vaddr, mode_t mode)
 
     // TODO: https://github.com/nanvix/microkernel/issues/367
 
+    // Check for kernel information page.
+    if (ALIGN(vaddr, PAGE_SIZE) == KINFO_BASE_VIRT) {
+        return (-1);
+    }
+
     // Parse request.
     switch (request) {
         case VMEM_CHMOD:
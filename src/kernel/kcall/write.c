@@ -7,9 +7,9 @@
  * Imports                                                                    *
  *============================================================================*/
 
+#include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 #include <nanvix/kernel/mm.h>
-#include <nanvix/libcore.h>
 #include <stddef.h>
 
 /*============================================================================*
@@ -17,17 +17,12 @@
  *============================================================================*/
 
 /**
- * @brief Write buffer size.
- */
-#define WRITE_BUFFER_SIZE 128
-
-/**
- * @details Writes a buffer to the kernel's standard output device.
+ * @details Writes a buffer to the kernel's standard output device. Bytes are
+ * appended straight from the user buffer to the output ring of the standard
+ * output device, which is drained asynchronously.
  */
 size_t kcall_write(int fd, const char *buf, size_t n)
 {
-    char buf2[WRITE_BUFFER_SIZE + 1];
-
     UNUSED(fd);
 
     /* Invalid file descriptor. */
@@ -38,20 +33,10 @@ size_t kcall_write(int fd, const char *buf, size_t n)
     if (buf == NULL)
         return (-1);
 
-    /* Invalid buffer size. */
-    if (n > WRITE_BUFFER_SIZE)
-        return (-1);
-
     /* Invalid buffer location. */
     if (!mm_check_area(VADDR(buf), n, UMEM_AREA)) {
         return (-1);
     }
 
-    /* Avoid overflow. */
-    __memcpy(buf2, buf, n);
-    buf2[n++] = '\0';
-
-    stdout_write(buf2, n);
-
-    return (n);
+    return (stdout_write_async(buf, n));
 }
@@ -20,27 +20,9 @@
 #include <stdint.h>
 #include <stdnoreturn.h>
 
-// TODO: place this on a header file.
+// TODO: place these on a header file.
 extern noreturn void handle_syscall(void);
-
-/*============================================================================*
- * Extern Functions                                                           *
- *============================================================================*/
-
-/**
- * @brief Runs unit tests on the Page Frame Allocator.
- */
-extern void test_frame(void);
-
-/**
- * @brief Runs unit tests on the Kernel Page Allocator.
- */
-extern void test_kpool(void);
-
-/**
- * @brief Runs unit tests on the User Page Allocator.
- */
-extern void test_upool(struct pde *pgdir);
+extern void kcall_handlers_start(void);
 
 /*============================================================================*
  * Private Variables                                                          *
@@ -119,16 +101,20 @@ noreturn void kmain(struct kargs *args)
     }
 
     hal_init();
+
+    // The master core runs the kernel under the kernel lock from now on.
+    klock_acquire();
+
     vmem_t root_vmem = mm_init();
     pm_init(root_vmem);
 
+    // Start application cores, now that the scheduler is up.
+    cores_start();
+    kinfo_cores(cores_online());
+
     // Initialize IPC modules.
     mailbox_init();
 
-    test_frame();
-    test_kpool();
-    test_upool((struct pde *)vmem_pgdir_get(root_vmem));
-
     // Spawn init server. Note that although we do create new processes, we will
     // not switch to it, because interrupts are disabled. This will save us from
     // a race condition in the system call dispatcher module.
@@ -136,7 +122,23 @@ noreturn void kmain(struct kargs *args)
 
     // Start handling system calls. Interrupts will be enabled as soon as we
     // block waiting for a kernel call to be issued.
+    kcall_handlers_start();
     handle_syscall();
 
     UNREACHABLE();
 }
+
+/**
+ * @brief Kernel main function of application cores.
+ *
+ * @param coreid ID of the underlying core.
+ *
+ * @returns This function does not return.
+ */
+noreturn void kmain_ap(unsigned coreid)
+{
+    UNUSED(coreid);
+
+    klock_acquire();
+    thread_core_start();
+}
@@ -27,6 +27,11 @@
  */
 #define FRAMES_SIZE (FRAMES_LENGTH * sizeof(bitmap_t))
 
+/**
+ * @brief First page frame for user use.
+ */
+#define FRAMES_USER_BASE (USER_BASE_PHYS >> PAGE_SHIFT)
+
 /*============================================================================*
  * Private Variables                                                          *
  *============================================================================*/
@@ -36,6 +41,11 @@
  */
 static bitmap_t frames[FRAMES_LENGTH];
 
+/**
+ * @brief Number of free page frames for user use.
+ */
+static unsigned frames_free = 0;
+
 /*============================================================================*
  * Private Functions                                                          *
  *============================================================================*/
@@ -51,6 +61,19 @@ static int frame_is_valid(frame_t frame)
     return (frame < NUM_FRAMES);
 }
 
+/**
+ * @brief Accounts a page frame that was allocated or released.
+ *
+ * @param frame Target frame.
+ * @param delta Change in the number of free page frames.
+ */
+static void frame_account(frame_t frame, int delta)
+{
+    if (frame >= FRAMES_USER_BASE) {
+        frames_free += delta;
+    }
+}
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
@@ -80,7 +103,7 @@ frame_t frame_alloc_any(void)
     bitmap_t bit;
 
     /* Search for a free frame. */
-    bit = bitmap_first_free(frames, USER_BASE_PHYS >> PAGE_SHIFT, FRAMES_SIZE);
+    bit = bitmap_first_free(frames, FRAMES_USER_BASE, FRAMES_SIZE);
 
     // Check wether we succeeded to allocate a frame.
     if (bit == BITMAP_FULL) {
@@ -89,6 +112,7 @@ frame_t frame_alloc_any(void)
     }
 
     bitmap_set(frames, bit);
+    frame_account(bit, -1);
 
     return (bit);
 }
@@ -114,6 +138,7 @@ int frame_alloc(frame_t frame)
 
     // Allocate request frame.
     bitmap_set(frames, bit);
+    frame_account(frame, -1);
 
     return (0);
 }
@@ -135,10 +160,19 @@ int frame_free(frame_t frame)
     }
 
     bitmap_clear(frames, bit);
+    frame_account(frame, 1);
 
     return (0);
 }
 
+/**
+ * @details Returns the number of page frames for user use that are free.
+ */
+unsigned frame_count_free(void)
+{
+    return (frames_free);
+}
+
 /**
  * @brief Books all page frames within a range.
  *
@@ -201,6 +235,7 @@ void frame_init(void)
     kprintf(MODULE_NAME " INFO: initializing the page frame allocator");
 
     __memset(frames, 0, FRAMES_SIZE);
+    frames_free = NUM_FRAMES - FRAMES_USER_BASE;
 
     // Print number of used page frames.
     kprintf(MODULE_NAME " INFO: %d page frames used",
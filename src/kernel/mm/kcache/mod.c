@@ -0,0 +1,253 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/errno.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm.h>
+#include <stdbool.h>
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Slab.
+ *
+ * @details A slab lies at the beginning of the kernel page that holds its
+ * objects. Free objects are chained through their first word.
+ */
+struct kslab {
+    struct kcache *cache; /** Owner cache.                */
+    struct kslab *prev;   /** Previous slab in the cache. */
+    struct kslab *next;   /** Next slab in the cache.     */
+    void *free;           /** First free object.          */
+    unsigned used;        /** Number of objects in use.   */
+};
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Links a slab at the head of the list of partial slabs of its cache.
+ *
+ * @param slab Target slab.
+ */
+static void kslab_link(struct kslab *slab)
+{
+    struct kcache *cache = slab->cache;
+
+    slab->prev = NULL;
+    slab->next = cache->partial;
+    if (cache->partial != NULL) {
+        cache->partial->prev = slab;
+    }
+    cache->partial = slab;
+}
+
+/**
+ * @brief Unlinks a slab from the list of partial slabs of its cache.
+ *
+ * @param slab Target slab.
+ */
+static void kslab_unlink(struct kslab *slab)
+{
+    struct kcache *cache = slab->cache;
+
+    if (slab->prev != NULL) {
+        slab->prev->next = slab->next;
+    } else {
+        cache->partial = slab->next;
+    }
+    if (slab->next != NULL) {
+        slab->next->prev = slab->prev;
+    }
+    slab->prev = NULL;
+    slab->next = NULL;
+}
+
+/**
+ * @brief Grows a kernel object cache by one slab.
+ *
+ * @param cache Target kernel object cache.
+ *
+ * @returns Upon successful completion, a pointer to the new slab is returned.
+ * Upon failure, NULL is returned instead.
+ */
+static struct kslab *kslab_create(struct kcache *cache)
+{
+    struct kslab *slab = kpage_get(false);
+    if (slab == NULL) {
+        return (NULL);
+    }
+
+    slab->cache = cache;
+    slab->used = 0;
+    slab->free = NULL;
+
+    // Chain objects in address order.
+    byte_t *base = (byte_t *)slab + cache->offset;
+    for (unsigned i = cache->capacity; i > 0; i--) {
+        void **obj = (void **)(base + ((i - 1) * cache->size));
+        *obj = slab->free;
+        slab->free = obj;
+    }
+
+    kslab_link(slab);
+    cache->nslabs++;
+
+    return (slab);
+}
+
+/**
+ * @brief Gives the kernel page of a slab back to the Kernel Page Pool.
+ *
+ * @param slab Target slab.
+ */
+static void kslab_destroy(struct kslab *slab)
+{
+    KASSERT(slab->used == 0);
+
+    kslab_unlink(slab);
+    slab->cache->nslabs--;
+    slab->cache = NULL;
+    KASSERT(kpage_put(slab) == 0);
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Initializes the kernel object cache pointed to by @p cache, for
+ * objects of @p size bytes aligned at @p align bytes. No slab is taken until
+ * the first object is allocated.
+ */
+int kcache_init(struct kcache *cache, const char *name, size_t size,
+                size_t align)
+{
+    // Check for invalid cache.
+    if (cache == NULL) {
+        return (-EINVAL);
+    }
+
+    // Check for invalid alignment.
+    if ((align == 0) || ((align & (align - 1)) != 0)) {
+        return (-EINVAL);
+    }
+
+    // Free objects must hold a link.
+    if (size < sizeof(void *)) {
+        size = sizeof(void *);
+    }
+    if (align < sizeof(void *)) {
+        align = sizeof(void *);
+    }
+
+    cache->name = name;
+    cache->size = TRUNCATE(size, align);
+    cache->offset = TRUNCATE(sizeof(struct kslab), align);
+
+    // Check if at least one object fits in a slab.
+    if ((cache->offset + cache->size) > PAGE_SIZE) {
+        return (-EINVAL);
+    }
+
+    cache->capacity = (PAGE_SIZE - cache->offset) / cache->size;
+    cache->nslabs = 0;
+    cache->nobjects = 0;
+    cache->partial = NULL;
+
+    return (0);
+}
+
+/**
+ * @details Takes the first free object of the first partial slab of the cache
+ * pointed to by @p cache. A new slab is taken from the Kernel Page Pool only if
+ * there is no partial slab.
+ */
+void *kcache_alloc(struct kcache *cache)
+{
+    struct kslab *slab = NULL;
+
+    // Check for invalid cache.
+    if ((cache == NULL) || (cache->capacity == 0)) {
+        return (NULL);
+    }
+
+    if ((slab = cache->partial) == NULL) {
+        if ((slab = kslab_create(cache)) == NULL) {
+            kprintf(MODULE_NAME " ERROR: %s cache overflow", cache->name);
+            return (NULL);
+        }
+    }
+
+    void **obj = slab->free;
+    slab->free = *obj;
+
+    // Full slabs are not tracked.
+    if (++slab->used == cache->capacity) {
+        kslab_unlink(slab);
+    }
+    cache->nobjects++;
+
+    __memset(obj, 0, cache->size);
+
+    return (obj);
+}
+
+/**
+ * @details Gives the object pointed to by @p obj back to its slab. The slab
+ * itself is given back to the Kernel Page Pool once it has no objects in use,
+ * unless it is the last partial slab of the cache pointed to by @p cache.
+ */
+int kcache_free(struct kcache *cache, void *obj)
+{
+    // Check for invalid cache.
+    if (cache == NULL) {
+        return (-EINVAL);
+    }
+
+    // Check for invalid object.
+    if ((obj == NULL) || !kpool_is_kpage(VADDR(obj))) {
+        return (-EINVAL);
+    }
+
+    struct kslab *slab = (struct kslab *)ALIGN(VADDR(obj), PAGE_SIZE);
+    const size_t offset = (byte_t *)obj - (byte_t *)slab;
+
+    // Check if object belongs to the target cache.
+    if ((slab->cache != cache) || (offset < cache->offset) ||
+        (((offset - cache->offset) % cache->size) != 0)) {
+        return (-EINVAL);
+    }
+
+    // Check for double free.
+    if (slab->used == 0) {
+        return (-EINVAL);
+    }
+
+    // Full slabs are tracked again as soon as they have a free object.
+    if (slab->used-- == cache->capacity) {
+        kslab_link(slab);
+    }
+    cache->nobjects--;
+
+    *(void **)obj = slab->free;
+    slab->free = obj;
+
+    // Keep one empty slab around, to avoid thrashing.
+    if ((slab->used == 0) && ((slab->prev != NULL) || (slab->next != NULL))) {
+        kslab_destroy(slab);
+    }
+
+    return (0);
+}
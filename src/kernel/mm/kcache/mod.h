@@ -0,0 +1,20 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#ifndef KERNEL_MM_KCACHE_H_
+#define KERNEL_MM_KCACHE_H_
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Name of this module.
+ */
+#define MODULE_NAME "[kernel][mm][kcache]"
+
+/*============================================================================*/
+
+#endif /* KERNEL_MM_KCACHE_H_ */
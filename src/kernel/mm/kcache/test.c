@@ -0,0 +1,199 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/errno.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm.h>
+#include <stddef.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Size of test objects (in bytes).
+ */
+#define TEST_OBJECT_SIZE 100
+
+/**
+ * @brief Alignment of test objects (in bytes).
+ */
+#define TEST_OBJECT_ALIGN 16
+
+/**
+ * @brief Number of test objects for stress tests.
+ */
+#define TEST_OBJECT_COUNT 256
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Kernel object cache for tests.
+ */
+static struct kcache cache;
+
+/**
+ * @brief Objects for stress tests.
+ */
+static void *objects[TEST_OBJECT_COUNT];
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Kernel Object Cache Initialization
+ */
+static void test_api_kcache_init(void)
+{
+    KASSERT(kcache_init(&cache, "test", TEST_OBJECT_SIZE, TEST_OBJECT_ALIGN) ==
+            0);
+    KASSERT(cache.size == TRUNCATE(TEST_OBJECT_SIZE, TEST_OBJECT_ALIGN));
+    KASSERT(cache.capacity > 1);
+    KASSERT(cache.nslabs == 0);
+    KASSERT(cache.nobjects == 0);
+}
+
+/**
+ * @brief API Test: Kernel Object Allocation
+ */
+static void test_api_kcache_allocation(void)
+{
+    unsigned char *obj;
+
+    KASSERT((obj = kcache_alloc(&cache)) != NULL);
+    KASSERT(kpool_is_kpage(VADDR(obj)));
+    KASSERT((VADDR(obj) & (TEST_OBJECT_ALIGN - 1)) == 0);
+    KASSERT(cache.nobjects == 1);
+
+    // Objects are handed out clean.
+    for (size_t i = 0; i < TEST_OBJECT_SIZE; i++) {
+        KASSERT(obj[i] == 0);
+    }
+
+    KASSERT(kcache_free(&cache, obj) == 0);
+    KASSERT(cache.nobjects == 0);
+}
+
+/**
+ * @brief API Test: Kernel Object Reuse
+ */
+static void test_api_kcache_reuse(void)
+{
+    void *obj1;
+    void *obj2;
+
+    KASSERT((obj1 = kcache_alloc(&cache)) != NULL);
+    KASSERT(kcache_free(&cache, obj1) == 0);
+    KASSERT((obj2 = kcache_alloc(&cache)) != NULL);
+    KASSERT(obj1 == obj2);
+    KASSERT(kcache_free(&cache, obj2) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Kernel Object Cache Initialization
+ */
+static void test_fault_kcache_invalid_init(void)
+{
+    struct kcache bad;
+
+    KASSERT(kcache_init(NULL, "test", TEST_OBJECT_SIZE, TEST_OBJECT_ALIGN) ==
+            -EINVAL);
+    KASSERT(kcache_init(&bad, "test", TEST_OBJECT_SIZE, 0) == -EINVAL);
+    KASSERT(kcache_init(&bad, "test", TEST_OBJECT_SIZE, 3) == -EINVAL);
+    KASSERT(kcache_init(&bad, "test", PAGE_SIZE, TEST_OBJECT_ALIGN) ==
+            -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Kernel Object Release
+ */
+static void test_fault_kcache_invalid_free(void)
+{
+    unsigned char *obj;
+
+    KASSERT(kcache_free(&cache, NULL) == -EINVAL);
+    KASSERT(kcache_free(&cache, (void *)(KPOOL_BASE_VIRT - PAGE_SIZE)) ==
+            -EINVAL);
+
+    // Misaligned object.
+    KASSERT((obj = kcache_alloc(&cache)) != NULL);
+    KASSERT(kcache_free(&cache, obj + 1) == -EINVAL);
+    KASSERT(kcache_free(&cache, obj) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Kernel Object Double Release
+ */
+static void test_fault_kcache_double_free(void)
+{
+    void *obj;
+
+    KASSERT((obj = kcache_alloc(&cache)) != NULL);
+    KASSERT(kcache_free(&cache, obj) == 0);
+    KASSERT(kcache_free(&cache, obj) == -EINVAL);
+}
+
+/**
+ * @brief Stress Test: Kernel Object Allocation
+ */
+static void test_stress_kcache_allocation(void)
+{
+    // Allocate objects across several slabs.
+    for (unsigned i = 0; i < TEST_OBJECT_COUNT; i++) {
+        KASSERT((objects[i] = kcache_alloc(&cache)) != NULL);
+    }
+    KASSERT(cache.nslabs > 1);
+    KASSERT(cache.nobjects == TEST_OBJECT_COUNT);
+
+    // Release all objects.
+    for (unsigned i = 0; i < TEST_OBJECT_COUNT; i++) {
+        KASSERT(kcache_free(&cache, objects[i]) == 0);
+    }
+    KASSERT(cache.nobjects == 0);
+
+    // Only one empty slab is kept around.
+    KASSERT(cache.nslabs == 1);
+}
+
+/**
+ * @brief Kernel Object Cache unit tests.
+ */
+static struct {
+    void (*test_fn)(void); /**< Test function.     */
+    const char *type;      /**< Name of test type. */
+    const char *name;      /**< Test Name.         */
+} kcache_tests[] = {
+    {test_api_kcache_init, "api", "kernel object cache init  "},
+    {test_api_kcache_allocation, "api", "kernel object allocation  "},
+    {test_api_kcache_reuse, "api", "kernel object reuse       "},
+    {test_fault_kcache_invalid_init, "fault", "kernel object cache init  "},
+    {test_fault_kcache_invalid_free, "fault", "kernel object release     "},
+    {test_fault_kcache_double_free, "fault", "kernel object double free "},
+    {test_stress_kcache_allocation, "stress", "kernel object allocation  "},
+    {NULL, NULL, NULL},
+};
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details This function runs self-tests on the Kernel Object Cache.
+ */
+void test_kcache(void)
+{
+    for (int i = 0; kcache_tests[i].test_fn != NULL; i++) {
+        kprintf(MODULE_NAME " TEST: %s", kcache_tests[i].name);
+        kcache_tests[i].test_fn();
+    }
+}
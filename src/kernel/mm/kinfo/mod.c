@@ -0,0 +1,138 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include "mod.h"
+#include <nanvix/cc.h>
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/mm.h>
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Kernel information page.
+ */
+static struct kinfo *kinfo = NULL;
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Starts an update on the kernel information page.
+ */
+static inline void kinfo_update_begin(void)
+{
+    kinfo->seq++;
+    noop();
+}
+
+/**
+ * @brief Ends an update on the kernel information page.
+ */
+static inline void kinfo_update_end(void)
+{
+    noop();
+    kinfo->seq++;
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Maps the kernel information page in the page directory pointed to
+ * by @p pgdir at address KINFO_BASE_VIRT. The page is mapped read-only.
+ */
+int kinfo_map(struct pde *pgdir)
+{
+    const frame_t frame = kpool_addr_to_frame(VADDR(kinfo));
+
+    if (upage_map(pgdir, KINFO_BASE_VIRT, frame, false, false) != 0) {
+        kprintf(MODULE_NAME " ERROR: failed to map kernel information page");
+        return (-1);
+    }
+
+    return (0);
+}
+
+/**
+ * @details Unmaps the kernel information page from the page directory pointed
+ * to by @p pgdir. The underlying kernel page is not released.
+ */
+int kinfo_unmap(struct pde *pgdir)
+{
+    const frame_t frame = kpool_addr_to_frame(VADDR(kinfo));
+
+    if (upage_unmap(pgdir, KINFO_BASE_VIRT) != frame) {
+        kprintf(MODULE_NAME " ERROR: failed to unmap kernel information page");
+        return (-1);
+    }
+
+    return (0);
+}
+
+/**
+ * @details Publishes the IDs of the thread that is about to run and of its
+ * owner process.
+ */
+void kinfo_switch(tid_t tid, pid_t pid)
+{
+    kinfo_update_begin();
+    kinfo->tid = tid;
+    kinfo->pid = pid;
+    kinfo->free_frames = frame_count_free();
+    kinfo_update_end();
+}
+
+/**
+ * @details Publishes the number of timer ticks.
+ */
+void kinfo_tick(void)
+{
+    kinfo_update_begin();
+    kinfo->ticks = interrupts_get_ticks();
+    kinfo->free_frames = frame_count_free();
+    kinfo_update_end();
+}
+
+/**
+ * @details Publishes the number of cores that are online.
+ */
+void kinfo_cores(unsigned ncores)
+{
+    kinfo_update_begin();
+    kinfo->cores = ncores;
+    kinfo_update_end();
+}
+
+/**
+ * @details Allocates and initializes the kernel information page.
+ */
+void kinfo_init(void)
+{
+    // Sanity check sizes.
+    KASSERT_SIZE(sizeof(struct kinfo), __SIZEOF_KINFO);
+
+    kprintf(MODULE_NAME " INFO: initializing the kernel information page");
+
+    if ((kinfo = kpage_get(true)) == NULL) {
+        kpanic("[mm] failed to allocate kernel information page");
+    }
+
+    kinfo->seq = 0;
+    kinfo->tid = 0;
+    kinfo->pid = 0;
+    kinfo->free_frames = frame_count_free();
+    kinfo->ticks = interrupts_get_ticks();
+    kinfo->cores = 1;
+    kinfo->reserved = 0;
+}
@@ -55,6 +55,11 @@ static struct pde root_pgdir[PGDIR_LENGTH] __attribute__((aligned(PAGE_SIZE)));
 static struct pte root_pgtabs[ROOT_PGTAB_NUM][PGTAB_LENGTH]
     __attribute__((aligned(PAGE_SIZE)));
 
+/**
+ * @brief Page table for memory-mapped I/O registers.
+ */
+static struct pte mmio_pgtab[PGTAB_LENGTH] __attribute__((aligned(PAGE_SIZE)));
+
 /*============================================================================*
  * Private Functions                                                          *
  *============================================================================*/
@@ -332,6 +337,14 @@ static void memory_map(struct phys_memory_region mem_layout_[VMEM_REGION])
         }
     }
 
+    // Identity map memory-mapped I/O registers, such as those of the Local
+    // APIC, so that every core can reach them with paging enabled.
+    for (paddr_t j = MMIO_BASE_PHYS; j < MMIO_END_PHYS; j += PAGE_SIZE) {
+        KASSERT(!mmu_page_map(mmio_pgtab, j, j, true, false));
+    }
+    mmu_pgtab_map(
+        root_pgdir, PADDR(mmio_pgtab), ALIGN(MMIO_BASE_PHYS, PGTAB_SIZE));
+
     /* Load virtual address space and enable MMU. */
     tlb_load(PADDR(root_pgdir));
 }
@@ -11,6 +11,30 @@
 #include <nanvix/kernel/lib.h>
 #include <nanvix/kernel/mm.h>
 
+/*============================================================================*
+ * Extern Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Runs unit tests on the Page Frame Allocator.
+ */
+extern void test_frame(void);
+
+/**
+ * @brief Runs unit tests on the Kernel Page Allocator.
+ */
+extern void test_kpool(void);
+
+/**
+ * @brief Runs unit tests on the Kernel Object Cache.
+ */
+extern void test_kcache(void);
+
+/**
+ * @brief Runs unit tests on the User Page Allocator.
+ */
+extern void test_upool(struct pde *pgdir);
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
@@ -27,5 +51,14 @@ vmem_t mm_init(void)
     vmem_t root_vmem = vmem_init(root_pgdir);
     upool_init();
 
+    // Run self-tests before any kernel page is handed out, because stress
+    // tests take every page of the kernel page pool.
+    test_frame();
+    test_kpool();
+    test_kcache();
+    test_upool((struct pde *)root_pgdir);
+
+    kinfo_init();
+
     return (root_vmem);
 }
@@ -19,8 +19,10 @@
 
 /**
  * @brief Maximum number of virtual memory spaces.
+ *
+ * @note This should be a power of two.
  */
-#define VMEM_MAX 16
+#define VMEM_MAX 128
 
 /*============================================================================*
  * Structures                                                                 *
@@ -43,6 +45,15 @@ struct vmem {
  */
 static struct vmem vmem_table[VMEM_MAX];
 
+/**
+ * @brief Queue of free virtual memory spaces, in release order.
+ */
+static struct {
+    unsigned head;          /** First free virtual memory space. */
+    unsigned tail;          /** Next free position.              */
+    vmem_t vmems[VMEM_MAX]; /** Virtual memory spaces.           */
+} free_vmems;
+
 /*============================================================================*
  * Private Functions                                                          *
  *============================================================================*/
@@ -65,19 +76,17 @@ static bool vmem_is_valid(vmem_t vmem)
  */
 static vmem_t vmem_alloc(void)
 {
-    // Traverse all entries in the table of virtual memory spaces.
-    for (int i = 0; i < VMEM_MAX; i++) {
-        // Check if entry is free.
-        if (!vmem_table[i].used) {
-            // It is, thus allocate and return it.
-            vmem_table[i].used = true;
-            return (i);
-        }
+    // Check if no free entry is left.
+    if (free_vmems.head == free_vmems.tail) {
+        kprintf(MODULE_NAME
+                " ERROR: no more virtual memory spaces are available");
+        return (VMEM_NULL);
     }
 
-    // No free entry was found.
-    kprintf(MODULE_NAME " ERROR: no more virtual memory spaces are available");
-    return (VMEM_NULL);
+    const vmem_t vmem = free_vmems.vmems[free_vmems.head++ & (VMEM_MAX - 1)];
+    vmem_table[vmem].used = true;
+
+    return (vmem);
 }
 
 /**
@@ -98,6 +107,7 @@ static int vmem_free(vmem_t vmem)
 
     // Release the target virtual memory space.
     vmem_table[vmem].used = false;
+    free_vmems.vmems[free_vmems.tail++ & (VMEM_MAX - 1)] = vmem;
 
     return (0);
 }
@@ -159,11 +169,18 @@ vmem_t vmem_create(void)
         }
     }
 
+    // Map kernel information page.
+    if (kinfo_map(new_pgdir) != 0) {
+        goto error2;
+    }
+
     // Initialize virtual memory space.
     vmem_table[vmem].pgdir = new_pgdir;
 
     return (vmem);
 
+error2:
+    kpage_put(new_pgdir);
 error1:
     vmem_free(vmem);
 error0:
@@ -189,12 +206,18 @@ int vmem_destroy(vmem_t vmem)
         return (-1);
     }
 
+    // Unmap kernel information page.
+    if (kinfo_unmap(vmem_table[vmem].pgdir) != 0) {
+        return (-1);
+    }
+
     // Check if the target virtual memory is busy.
     for (unsigned i = pde_idx_get(USER_BASE_VIRT);
          i < pde_idx_get(USER_END_VIRT);
          i++) {
         if (pde_is_present(&vmem_table[vmem].pgdir[i])) {
             kprintf(MODULE_NAME " ERROR: virtual memory space is busy");
+            KASSERT(kinfo_map(vmem_table[vmem].pgdir) == 0);
             return (-1);
         }
     }
@@ -331,9 +354,11 @@ vmem_t vmem_init(const struct pde *root_pgdir)
 
     kprintf(MODULE_NAME "initializing the virtual memory manager...");
 
+    // The root virtual memory space is never released.
     for (int i = 1; i < VMEM_MAX; i++) {
         vmem_table[i].used = false;
         vmem_table[i].pgdir = NULL;
+        free_vmems.vmems[free_vmems.tail++ & (VMEM_MAX - 1)] = i;
     }
 
     vmem_table[0].used = true;
@@ -7,39 +7,182 @@
  * Imports                                                                    *
  *============================================================================*/
 
+#include <nanvix/errno.h>
 #include <nanvix/kernel/hal.h>
 #include <nanvix/kernel/lib.h>
 #include <nanvix/kernel/pm.h>
 
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Inserts a thread at the end of the queue of a condition variable.
+ *
+ * @param cond Target condition variable.
+ * @param t    Target thread.
+ */
+static void cond_enqueue(struct condvar *cond, struct thread *t)
+{
+    t->wchan = cond;
+    t->wnext = NULL;
+    if (cond->tail != NULL) {
+        cond->tail->wnext = t;
+    } else {
+        cond->head = t;
+    }
+    cond->tail = t;
+}
+
+/**
+ * @brief Removes the first thread from the queue of a condition variable.
+ *
+ * @param cond Target condition variable.
+ *
+ * @returns A pointer to the removed thread is returned. If no thread is
+ * waiting on @p cond, NULL is returned instead.
+ */
+static struct thread *cond_dequeue(struct condvar *cond)
+{
+    struct thread *t = cond->head;
+
+    if (t != NULL) {
+        cond->head = t->wnext;
+        if (cond->head == NULL) {
+            cond->tail = NULL;
+        }
+        t->wchan = NULL;
+        t->wnext = NULL;
+    }
+
+    return (t);
+}
+
+/**
+ * @brief Removes a thread from anywhere in the queue of a condition variable.
+ *
+ * @param cond Target condition variable.
+ * @param t    Target thread.
+ */
+static void cond_remove(struct condvar *cond, struct thread *t)
+{
+    struct thread *prev = NULL;
+
+    for (struct thread *it = cond->head; it != NULL; it = it->wnext) {
+        if (it == t) {
+            if (prev != NULL) {
+                prev->wnext = t->wnext;
+            } else {
+                cond->head = t->wnext;
+            }
+            if (cond->tail == t) {
+                cond->tail = prev;
+            }
+            break;
+        }
+        prev = it;
+    }
+
+    t->wchan = NULL;
+    t->wnext = NULL;
+}
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
 
 /**
- * @details This function causes the calling process to block, until the
- * condition variable pointed to by @p cond is signaled and the calling process
- * is chosen to run.
+ * @details This function causes the calling thread to block, until the
+ * condition variable pointed to by @p cond is signaled and the calling thread
+ * is chosen to run. Other threads of the calling process keep running.
  *
- * @see cond_broadcast()
+ * @see cond_signal(), cond_broadcast()
  */
 int cond_wait(struct condvar *cond)
+{
+    return (cond_wait_to(cond, -1));
+}
+
+/**
+ * @details This function works like `cond_wait()`, but the calling thread
+ * hands the remainder of its time slice over to the thread identified by
+ * @p tid, if that thread is ready.
+ *
+ * @see cond_wait()
+ */
+int cond_wait_to(struct condvar *cond, tid_t tid)
+{
+    KASSERT(cond != NULL);
+
+    struct thread *curr_thread = thread_get(thread_get_curr());
+    KASSERT(curr_thread != NULL);
+
+    // Enqueue calling thread.
+    cond_enqueue(cond, curr_thread);
+
+    // Put the calling thread to sleep.
+    thread_sleep_to(tid);
+
+    // Woken up by someone else, thus leave the queue.
+    if (UNLIKELY(curr_thread->wchan == cond)) {
+        cond_remove(cond, curr_thread);
+    }
+
+    return (0);
+}
+
+/**
+ * @details This function works like `cond_wait()`, but the calling thread
+ * gives up waiting once @p ticks timer ticks elapse. If @p ticks is zero, the
+ * calling thread does not block at all.
+ *
+ * @see cond_wait()
+ */
+int cond_wait_timeout(struct condvar *cond, unsigned ticks)
 {
     KASSERT(cond != NULL);
 
-    struct process *curr_process = process_get_curr();
+    if (ticks == 0) {
+        return (-ETIMEDOUT);
+    }
+
+    struct thread *curr_thread = thread_get(thread_get_curr());
+    KASSERT(curr_thread != NULL);
+
+    // Enqueue calling thread.
+    cond_enqueue(cond, curr_thread);
+
+    // Put the calling thread to sleep.
+    const int ret = thread_sleep_timeout(ticks);
+
+    // Timed out or woken up by someone else, thus leave the queue.
+    if (curr_thread->wchan == cond) {
+        cond_remove(cond, curr_thread);
+    }
+
+    return (ret);
+}
 
-    /* Enqueue calling process. */
-    curr_process->next = cond->queue;
-    cond->queue = curr_process;
+/**
+ * @details This function sends a wakeup signal to the thread that has been
+ * waiting the longest on the condition variable pointed to by @p cond.
+ *
+ * @see cond_wait().
+ */
+int cond_signal(struct condvar *cond)
+{
+    KASSERT(cond != NULL);
 
-    /* Put the calling process to sleep. */
-    process_sleep();
+    struct thread *t = cond_dequeue(cond);
+    if (t != NULL) {
+        KASSERT(thread_wakeup(t->tid) == 0);
+    }
 
     return (0);
 }
 
 /**
- * @details This function sends a wakeup signal to all processes that are
+ * @details This function sends a wakeup signal to all threads that are
  * currently blocked waiting on the conditional variable pointed to by @p cond.
  *
  * @see cond_wait().
@@ -48,11 +191,25 @@ int cond_broadcast(struct condvar *cond)
 {
     KASSERT(cond != NULL);
 
-    /* Wakeup all processes. */
-    while (UNLIKELY(cond->queue != NULL)) {
-        process_wakeup(cond->queue);
-        cond->queue = cond->queue->next;
+    struct thread *t = NULL;
+
+    // Wakeup all threads.
+    while ((t = cond_dequeue(cond)) != NULL) {
+        KASSERT(thread_wakeup(t->tid) == 0);
     }
 
     return (0);
 }
+
+/**
+ * @details This function removes the thread pointed to by @p t from the queue
+ * of the condition variable that it waits on, if any, without waking it up.
+ */
+void cond_leave(struct thread *t)
+{
+    KASSERT(t != NULL);
+
+    if (t->wchan != NULL) {
+        cond_remove(t->wchan, t);
+    }
+}
@@ -40,36 +40,61 @@ extern vaddr_t elf32_load(const struct elf32_fhdr *elf);
  *============================================================================*/
 
 /**
- * @brief Process table.
+ * @brief Kernel process.
+ */
+static struct process kernel_process;
+
+/**
+ * @brief Process index, by process ID.
+ */
+static struct process *processes[PROCESS_MAX];
+
+/**
+ * @brief Cache of process control blocks.
  */
-static struct process processes[PROCESS_MAX];
+static struct kcache process_cache;
+
+/**
+ * @brief Queue of free process IDs, in release order.
+ */
+static struct {
+    unsigned head;           /** First free process ID. */
+    unsigned tail;           /** Next free position.    */
+    pid_t pids[PROCESS_MAX]; /** Process IDs.           */
+} free_pids;
 
 /**
  * @brief Kernel process.
  */
-static struct process *kernel = &processes[KERNEL_PROCESS];
+static struct process *kernel = &kernel_process;
 
 /*============================================================================*
  * Private Functions                                                          *
  *============================================================================*/
 
 /**
- * @brief Allocates an entry in the process table.
+ * @brief Allocates a process control block and a process ID.
  *
- * @returns Upon successful completion, a pointer to the allocated entry in the
- * process table is returned. Upon failure, NULL is returned instead.
+ * @returns Upon successful completion, a pointer to the allocated process
+ * control block is returned. Upon failure, NULL is returned instead.
  */
 static struct process *process_alloc(void)
 {
-    // Find a process control block that is not in use.
-    for (int i = 0; i < PROCESS_MAX; i++) {
-        if (!processes[i].active) {
-            processes[i].active = true;
-            return (&processes[i]);
-        }
+    // No process ID is available.
+    if (free_pids.head == free_pids.tail) {
+        return (NULL);
     }
 
-    return (NULL);
+    struct process *process = kcache_alloc(&process_cache);
+    if (process == NULL) {
+        return (NULL);
+    }
+
+    process->pid = free_pids.pids[free_pids.head++ & (PROCESS_MAX - 1)];
+    process->active = true;
+    processes[process->pid] = process;
+
+    return (process);
 }
 
 /**
@@ -80,10 +105,16 @@ static struct process *process_alloc(void)
 static void process_free(struct process *process)
 {
     KASSERT(process != kernel);
-    process->pid = 0;
+
+    // Release threads while the process is still valid.
+    thread_free_all(process->pid);
+
+    processes[process->pid] = NULL;
+    free_pids.pids[free_pids.tail++ & (PROCESS_MAX - 1)] = process->pid;
+
     process->active = false;
     process->image = NULL;
-    thread_free_all(process->pid);
+    KASSERT(kcache_free(&process_cache, process) == 0);
 }
 
 /*============================================================================*
@@ -101,7 +132,7 @@ int process_is_valid(pid_t pid)
     }
 
     // Check if process is not active.
-    if (!processes[pid].active) {
+    if ((processes[pid] == NULL) || !processes[pid]->active) {
         return (-EINVAL);
     }
 
@@ -120,18 +151,11 @@ struct process *process_get(pid_t pid)
     }
 
     // Check if process is not active.
-    if (!processes[pid].active) {
+    if ((processes[pid] == NULL) || !processes[pid]->active) {
         return (NULL);
     }
 
-    // Find process.
-    for (int i = 0; i < PROCESS_MAX; i++) {
-        if (processes[i].pid == pid) {
-            return (&processes[i]);
-        }
-    }
-
-    return (NULL);
+    return (processes[pid]);
 }
 
 /**
@@ -152,9 +176,7 @@ void do_process_setup(void)
     const vaddr_t user_fn_addr = elf32_load(running->image);
     KASSERT(user_fn_addr == USER_BASE_VIRT);
 
-    vaddr_t user_stack_addr = USER_END_VIRT - PAGE_SIZE;
-
-    KASSERT(vmem_attach(running->vmem, user_stack_addr, PAGE_SIZE) == 0);
+    // The user stack is mapped on demand, as soon as it is touched.
 }
 
 /**
@@ -162,7 +184,6 @@ void do_process_setup(void)
  */
 pid_t process_create(const void *image)
 {
-    static pid_t next_pid = 0;
     struct process *process = NULL;
 
     // Find a process control block that is not in use.
@@ -177,14 +198,13 @@ pid_t process_create(const void *image)
     }
 
     // Initializes process control block.
-    process->pid = ++next_pid;
     process->image = image;
     process->vmem = vmem;
     process->ustackmap = 0;
 
     // Creates a thread.
     if ((process->tid = thread_create(
-             process, (void *(*)())USER_BASE_VIRT, NULL, NULL)) < 0) {
+             process, (void *(*)())USER_BASE_VIRT, NULL, NULL, 0)) < 0) {
         goto error2;
     }
 
@@ -234,14 +254,26 @@ void process_init(vmem_t root_vmem)
 {
     log(INFO, "initializing process system...");
 
-    // Initializes the table of processes.
-    for (int i = 0; i < PROCESS_MAX; i++) {
-        processes[i].active = false;
-        processes[i].image = NULL;
+    // Initializes the cache of process control blocks.
+    KASSERT(kcache_init(&process_cache,
+                        "process",
+                        sizeof(struct process),
+                        _Alignof(struct process)) == 0);
+
+    // Initializes the process index. The kernel process ID is never released.
+    for (pid_t pid = 0; pid < PROCESS_MAX; pid++) {
+        processes[pid] = NULL;
+        if (pid != KERNEL_PROCESS) {
+            free_pids.pids[free_pids.tail++ & (PROCESS_MAX - 1)] = pid;
+        }
     }
 
     // Initialize.
+    kernel->pid = KERNEL_PROCESS;
+    kernel->tid = 0;
+    kernel->image = NULL;
     kernel->vmem = (vmem_t)root_vmem;
     kernel->active = true;
+    processes[KERNEL_PROCESS] = kernel;
     thread_init();
 }
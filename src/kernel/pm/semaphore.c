@@ -115,6 +115,74 @@ static int semaphore_drop(int semid)
     return (-1);
 }
 
+/**
+ * @brief Removes a semaphore from the list of semaphores held by its holder.
+ *
+ * @param sem Target semaphore.
+ */
+static void semaphore_unhold(struct semaphore *sem)
+{
+    struct thread *t = thread_get(sem->holder);
+
+    if (t != NULL) {
+        for (struct semaphore **p = &t->held; *p != NULL; p = &(*p)->next) {
+            if (*p == sem) {
+                *p = sem->next;
+                break;
+            }
+        }
+    }
+
+    sem->holder = -1;
+    sem->next = NULL;
+}
+
+/**
+ * @brief Records the calling thread as the holder of a semaphore.
+ *
+ * @param sem Target semaphore.
+ */
+static void semaphore_hold(struct semaphore *sem)
+{
+    const tid_t tid = thread_get_curr();
+    struct thread *t = thread_get(tid);
+
+    if (sem->holder == tid) {
+        return;
+    }
+
+    semaphore_unhold(sem);
+    sem->holder = tid;
+    sem->next = t->held;
+    t->held = sem;
+}
+
+/**
+ * @brief Gets the highest priority that waiters lend to a thread.
+ *
+ * @details The semaphores that the target thread still holds are traversed,
+ * and the priority of each thread that waits on them is considered.
+ *
+ * @param t Target thread.
+ *
+ * @returns The highest priority of threads that wait on semaphores held by the
+ * target thread, or THREAD_PRIO_MIN if there are none.
+ */
+static int semaphore_prio_lent(const struct thread *t)
+{
+    int prio = THREAD_PRIO_MIN;
+
+    for (struct semaphore *sem = t->held; sem != NULL; sem = sem->next) {
+        for (struct thread *w = sem->cond.head; w != NULL; w = w->wnext) {
+            if (w->prio > prio) {
+                prio = w->prio;
+            }
+        }
+    }
+
+    return (prio);
+}
+
 /*============================================================================*
  * Public Functions                                                           *
  *============================================================================*/
@@ -140,6 +208,7 @@ int semaphore_set(int semid, int count)
         return (-1);
     }
 
+    semaphore_unhold(&semtable[semid]);
     semaphore_init(&semtable[semid], count);
 
     return 0;
@@ -253,6 +322,7 @@ void semtable_init(void)
     }
 
     for (int semid = 0; semid < SEMAPHORE_MAX; semid++) {
+        semaphore_init(&semtable[semid], 0);
         semtable[semid].state = SEMAPHORE_INACTIVE;
         init_proc_users(semid);
     }
@@ -261,32 +331,64 @@ void semtable_init(void)
 /**
  * @details This function performs a down operation in the semaphore pointed to
  * by @p sem. It atomically checks the current value of @p sem. If it is greater
- * than one, it decrements the semaphore counter by one and the calling process
- * continue its execution, flow as usual.  Otherwise, the calling process sleeps
- * until another process performs a call to semaphore_up() on this semaphore.
+ * than one, it decrements the semaphore counter by one and the calling thread
+ * continue its execution, flow as usual.  Otherwise, the calling thread sleeps
+ * until another thread performs a call to semaphore_up() on this semaphore.
+ *
+ * While the calling thread waits, the thread that last acquired @p sem
+ * inherits its priority, so that it is not stalled by threads with lower
+ * priority than the waiter.
  *
  * @see SEMAPHORE_INIT(), semaphore_up()
  */
 void semaphore_down(struct semaphore *sem)
+{
+    KASSERT(semaphore_down_timeout(sem, TIMEOUT_INFINITE) == 0);
+}
+
+/**
+ * @details This function performs a down operation in the semaphore pointed to
+ * by @p sem, like semaphore_down() does, but the calling thread gives up once
+ * @p ticks timer ticks elapse. If @p ticks is zero, the calling thread does not
+ * block at all.
+ *
+ * @see semaphore_down()
+ */
+int semaphore_down_timeout(struct semaphore *sem, unsigned ticks)
 {
     KASSERT(sem != NULL);
 
+    const uint64_t deadline = timeout_deadline(ticks);
     while (true) {
         if (sem->count > 0) {
             break;
         }
 
-        cond_wait(&sem->cond);
+        thread_prio_inherit(sem->holder, thread_prio_curr());
+        const int ret =
+            cond_wait_timeout(&sem->cond, timeout_remaining(deadline));
+
+        // Timed out.
+        if ((ret < 0) && (sem->count == 0)) {
+            return (ret);
+        }
     }
 
     sem->count--;
+    semaphore_hold(sem);
+
+    return (0);
 }
 
 /**
  * @details This function performs an up operation in a semaphore pointed to by
- * @p sem. It atomically increments the current value of @p and wakes up all
- * processes that were sleeping in this semaphore, waiting for a semaphore_up()
- * operation.
+ * @p sem. It atomically increments the current value of @p and wakes up the
+ * thread that has been sleeping the longest in this semaphore, waiting for a
+ * semaphore_up() operation.
+ *
+ * If the calling thread holds @p sem, it drops the priority that waiters on
+ * @p sem lent to it, but keeps the priority lent through the semaphores that
+ * it still holds.
  *
  * @see SEMAPHORE_INIT(), semaphore_down()
  */
@@ -294,6 +396,29 @@ void semaphore_up(struct semaphore *sem)
 {
     KASSERT(sem != NULL);
 
+    const tid_t tid = thread_get_curr();
+    if (sem->holder == tid) {
+        semaphore_unhold(sem);
+        thread_prio_restore(tid, semaphore_prio_lent(thread_get(tid)));
+    }
+
     sem->count++;
-    cond_broadcast(&sem->cond);
+    cond_signal(&sem->cond);
+}
+
+/**
+ * @details Forgets the thread identified by @p tid as the holder of the
+ * semaphores that it holds.
+ */
+void semaphore_drop_held(tid_t tid)
+{
+    struct thread *t = thread_get(tid);
+
+    if (t == NULL) {
+        return;
+    }
+
+    while (t->held != NULL) {
+        semaphore_unhold(t->held);
+    }
 }
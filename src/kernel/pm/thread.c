@@ -11,6 +11,7 @@
 #include <nanvix/kernel/log.h>
 #include <nanvix/kernel/mm.h>
 #include <nanvix/kernel/pm/process.h>
+#include <nanvix/kernel/pm/semaphore.h>
 #include <nanvix/kernel/pm/thread.h>
 #include <stdnoreturn.h>
 
@@ -19,28 +20,164 @@
  *============================================================================*/
 
 /**
- * @brief Thread quantum.
+ * @brief Kernel main thread.
  */
-#define THREAD_QUANTUM 100
+#define KERNEL_THREAD 0
 
 /**
- * @brief Kernel main thread.
+ * @brief Fixed-point shift of the rate of virtual runtime.
  */
-#define KERNEL_THREAD 0
+#define SHARE_RATE_SHIFT 16
+
+/**
+ * @brief Virtual runtime (in cycles) that a process keeps as credit while its
+ * threads are not ready.
+ *
+ * @details A process whose threads blocked for a long time does not get to
+ * run alone until it catches up with other processes, but it still runs ahead
+ * of them for a while.
+ */
+#define SHARE_CREDIT (1ULL << 24)
+
+/**
+ * @brief Number of bitmap words that track processes with ready threads.
+ */
+#define READY_MASK_LENGTH (PROCESS_MAX / BITMAP_WORD_LENGTH)
+
+// Processes with ready threads at a priority level are tracked in a bitmap.
+#if ((PROCESS_MAX % BITMAP_WORD_LENGTH) != 0)
+#error "PROCESS_MAX should be a multiple of BITMAP_WORD_LENGTH"
+#endif
+
+/*============================================================================*
+ * Structures                                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Queue of ready threads.
+ */
+struct ready_queue {
+    struct thread *head; /** First thread. */
+    struct thread *tail; /** Last thread.  */
+};
+
+/**
+ * @brief Regular ready threads of a priority level.
+ *
+ * @details Threads are queued by process, so that fair share only looks at
+ * the first thread of each process.
+ */
+struct ready_level {
+    bitmap_t active[READY_MASK_LENGTH];    /** Processes with threads. */
+    struct ready_queue procs[PROCESS_MAX]; /** Queues, by process.     */
+};
+
+/**
+ * @brief Fair share state of a process.
+ */
+struct share {
+    struct thread_share params; /** Parameters.               */
+    unsigned rate;              /** Rate of virtual runtime.  */
+    uint64_t vruntime;          /** Virtual runtime.          */
+    uint64_t release;           /** Start of period.          */
+    unsigned used;              /** Quota used in period.     */
+    bool throttled;             /** Quota overrun?            */
+    struct timeout timer;       /** Period timer.             */
+};
+
+/**
+ * @brief Cache of stacks of a process.
+ */
+struct stack_cache {
+    unsigned count; /** Cached stacks. */
+    struct {
+        byte_t *kstack;     /** Kernel stack.        */
+        byte_t *ustack;     /** User stack (top).    */
+        byte_t *ustack_low; /** Lowest mapped page.  */
+    } stacks[THREAD_STACK_CACHE_MAX]; /** Stacks, warmest last. */
+};
+
+/**
+ * @brief Scheduling state of a core.
+ */
+struct core_sched {
+    struct thread *running;                       /** Running thread.   */
+    struct thread *idle;                          /** Idle thread.      */
+    struct thread *zombie;                        /** Released thread.  */
+    unsigned nready;                              /** Ready threads.    */
+    bool preempt;                                 /** Preempting?       */
+    pid_t as_pid;                                 /** Loaded space.     */
+    unsigned affinity_run;                        /** Heads passed by.  */
+    struct ready_queue rt;                        /** Real-time queue.  */
+    struct ready_level ready[THREAD_PRIO_LEVELS]; /** Queues, by prio.  */
+};
 
 /*============================================================================*
  * Private Variables                                                          *
  *============================================================================*/
 
 /**
- * @brief Thread table.
+ * @brief Kernel main thread.
+ */
+static struct thread kernel_thread;
+
+/**
+ * @brief Thread index, by thread ID.
+ */
+static struct thread *threads[THREADS_MAX];
+
+/**
+ * @brief Cache of thread control blocks.
+ */
+static struct kcache thread_cache;
+
+/**
+ * @brief Queue of free thread IDs, in release order.
+ */
+static struct {
+    unsigned head;           /** First free thread ID. */
+    unsigned tail;           /** Next free position.   */
+    tid_t tids[THREADS_MAX]; /** Thread IDs.           */
+} free_tids;
+
+/**
+ * @brief Statistics of released threads, by process ID.
+ */
+static struct thread_stats released_stats[PROCESS_MAX];
+
+/**
+ * @brief Caches of stacks, by process ID.
+ */
+static struct stack_cache stack_caches[PROCESS_MAX];
+
+/**
+ * @brief Fair share state, by process ID.
+ */
+static struct share shares[PROCESS_MAX];
+
+/**
+ * @brief Virtual runtime of the last process that was picked to run.
+ *
+ * @details This never goes back, and it stays close to the least virtual
+ * runtime of all processes with ready threads.
+ */
+static uint64_t share_floor = 0;
+
+/**
+ * @brief Density of all real-time threads.
+ */
+static unsigned rt_density = 0;
+
+/**
+ * @brief Bound of address space affinity.
  */
-static struct thread threads[THREADS_MAX];
+static unsigned affinity_bound = THREAD_AFFINITY_DEFAULT;
 
 /**
- * @brief Running thread.
+ * @brief Scheduling state of each core.
  */
-static struct thread *running = &threads[KERNEL_THREAD];
+static struct core_sched cores[KERNEL_CORES_MAX] = {
+    [CORE_MASTER] = {.running = &kernel_thread}};
 
 /*============================================================================*
  * Extern Declarations                                                        *
@@ -61,413 +198,2418 @@ extern void __do_process_setup(void);
  *============================================================================*/
 
 /**
- * @details Checks if there is an entry avaible in the thread table.
+ * @brief Gets the scheduling state of the underlying core.
+ *
+ * @returns The scheduling state of the underlying core.
+ */
+static inline struct core_sched *core_sched(void)
+{
+    return (&cores[core_get_id()]);
+}
+
+/**
+ * @brief Gets the thread that is running on the underlying core.
+ *
+ * @returns The thread that is running on the underlying core.
+ */
+static inline struct thread *thread_running(void)
+{
+    return (core_sched()->running);
+}
+
+/**
+ * @brief Checks if a thread is running on another core.
+ *
+ * @param t Target thread.
+ *
+ * @returns If @p t is running on a core other than the underlying one, true is
+ * returned. Otherwise, false is returned instead.
+ */
+static bool thread_is_remote(const struct thread *t)
+{
+    return ((t->core != core_get_id()) && (cores[t->core].running == t));
+}
+
+/**
+ * @brief Checks if a thread is in the real-time class.
+ *
+ * @param t Target thread.
+ *
+ * @returns If @p t is a real-time thread, true is returned. Otherwise, false is
+ * returned instead.
+ */
+static inline bool thread_is_rt(const struct thread *t)
+{
+    return (t->rt.period != 0);
+}
+
+/**
+ * @brief Checks if a thread is held back by the quota of its process.
+ *
+ * @param t Target thread.
+ *
+ * @returns If @p t is in the regular class and its process overran its quota,
+ * true is returned. Otherwise, false is returned instead.
+ */
+static inline bool thread_is_capped(const struct thread *t)
+{
+    return (!thread_is_rt(t) && shares[t->pid].throttled);
+}
+
+/**
+ * @brief Resets the fair share state of a process.
+ *
+ * @details The target process gets the default weight, no quota, and the
+ * virtual runtime of the last process that was picked to run.
+ *
+ * @param pid ID of the target process.
+ */
+static void share_reset(pid_t pid)
+{
+    struct share *s = &shares[pid];
+
+    timeout_clear(&s->timer);
+    s->params.weight = THREAD_SHARE_WEIGHT_DEFAULT;
+    s->params.quota = 0;
+    s->params.period = 0;
+    s->rate = 1 << SHARE_RATE_SHIFT;
+    s->vruntime = share_floor;
+    s->release = 0;
+    s->used = 0;
+    s->throttled = false;
+}
+
+/**
+ * @brief Limits the virtual runtime credit of a process.
+ *
+ * @details This is called whenever a thread of the target process becomes
+ * ready, so that the virtual runtime of the target process is not left far
+ * behind that of other processes.
+ *
+ * @param pid ID of the target process.
+ */
+static void share_credit(pid_t pid)
+{
+    struct share *s = &shares[pid];
+
+    if ((s->vruntime + SHARE_CREDIT) < share_floor) {
+        s->vruntime = share_floor - SHARE_CREDIT;
+    }
+}
+
+/**
+ * @brief Charges a timer tick to the quota of the process of a thread.
+ *
+ * @details Periods start on the first tick that is charged after the previous
+ * period ended. Once the target process overruns its quota, it is throttled
+ * until its period ends.
+ *
+ * @param t Target thread.
+ *
+ * @returns If the process of @p t is throttled, true is returned. Otherwise,
+ * false is returned instead.
+ */
+static bool share_charge(const struct thread *t)
+{
+    struct share *s = &shares[t->pid];
+    const uint64_t now = interrupts_get_ticks();
+
+    if (s->params.quota == 0) {
+        return (false);
+    }
+
+    // Another core throttled the target process meanwhile.
+    if (s->throttled) {
+        return (true);
+    }
+
+    if (now >= (s->release + s->params.period)) {
+        s->release = now;
+        s->used = 0;
+    }
+
+    if (++s->used < s->params.quota) {
+        return (false);
+    }
+
+    s->throttled = true;
+    timeout_set(&s->timer, (unsigned)((s->release + s->params.period) - now));
+
+    return (true);
+}
+
+/**
+ * @brief Handles the period timer of a process that overran its quota.
+ *
+ * @details The quota of the target process is replenished, and its threads
+ * may run again. They are still in the ready queues.
+ *
+ * @param arg Fair share state of the target process.
+ */
+static void share_timer(void *arg)
+{
+    struct share *s = arg;
+
+    s->release = interrupts_get_ticks();
+    s->used = 0;
+    s->throttled = false;
+}
+
+/**
+ * @brief Gets the queue of ready threads that a thread belongs in.
+ *
+ * @param t Target thread.
+ *
+ * @returns The real-time queue of the core of @p t, if @p t is a real-time
+ * thread. Otherwise, the ready queue of the process of @p t at the priority
+ * level of @p t.
+ */
+static inline struct ready_queue *ready_queue(const struct thread *t)
+{
+    struct core_sched *core = &cores[t->core];
+
+    return (thread_is_rt(t) ? &core->rt : &core->ready[t->prio].procs[t->pid]);
+}
+
+/**
+ * @brief Appends a thread to the queue of ready threads of its core.
+ *
+ * @details Real-time threads are kept sorted by deadline instead, and those
+ * that overran their budget are not queued until their next period.
+ *
+ * @param t Target thread.
+ */
+static void ready_push(struct thread *t)
+{
+    struct ready_queue *queue = ready_queue(t);
+    struct thread *it = NULL;
+
+    if (t->rt_throttled) {
+        return;
+    }
+
+    // Queue real-time threads ahead of those with a later deadline.
+    if (thread_is_rt(t)) {
+        for (it = queue->head; it != NULL; it = it->next) {
+            if (it->rt_deadline > t->rt_deadline) {
+                break;
+            }
+        }
+    } else {
+        share_credit(t->pid);
+        bitmap_set(cores[t->core].ready[t->prio].active, t->pid);
+    }
+
+    t->next = it;
+    t->prev = (it != NULL) ? it->prev : queue->tail;
+
+    if (t->prev != NULL) {
+        t->prev->next = t;
+    } else {
+        queue->head = t;
+    }
+    if (it != NULL) {
+        it->prev = t;
+    } else {
+        queue->tail = t;
+    }
+    cores[t->core].nready++;
+}
+
+/**
+ * @brief Removes a thread from the queue of ready threads of its core.
+ *
+ * @param t Target thread.
+ */
+static void ready_remove(struct thread *t)
+{
+    struct ready_queue *queue = ready_queue(t);
+
+    if (t->rt_throttled) {
+        return;
+    }
+
+    if (t->prev != NULL) {
+        t->prev->next = t->next;
+    } else {
+        queue->head = t->next;
+    }
+
+    if (t->next != NULL) {
+        t->next->prev = t->prev;
+    } else {
+        queue->tail = t->prev;
+    }
+
+    if (!thread_is_rt(t) && (queue->head == NULL)) {
+        bitmap_clear(cores[t->core].ready[t->prio].active, t->pid);
+    }
+
+    t->prev = NULL;
+    t->next = NULL;
+    cores[t->core].nready--;
+}
+
+/**
+ * @brief Changes the state of a thread.
+ *
+ * @details A thread is linked in the queue of ready threads if and only if it
+ * is in the ready state, thus every state transition goes through here. A
+ * thread that is still running on another core is never queued: it is kept
+ * running instead.
+ *
+ * @param t     Target thread.
+ * @param state New state.
+ */
+static void thread_set_state(struct thread *t, short state)
+{
+    if ((state == THREAD_READY) && thread_is_remote(t)) {
+        state = THREAD_RUNNING;
+    }
+
+    if ((t->state == THREAD_READY) && (state != THREAD_READY)) {
+        ready_remove(t);
+        t->stats.ready_cycles += cpu_cycles() - t->ready_stamp;
+    } else if ((t->state != THREAD_READY) && (state == THREAD_READY)) {
+        ready_push(t);
+        t->ready_stamp = cpu_cycles();
+    }
+
+    t->state = state;
+}
+
+/**
+ * @brief Gets the next thread to run from a priority level of regular ready
+ * threads, by fair share.
+ *
+ * @details Only processes that have ready threads at the target priority level
+ * are looked at, thus this takes at most PROCESS_MAX steps, however many
+ * threads are ready.
+ *
+ * @param level Target priority level.
+ *
+ * @returns A pointer to the first thread of the process with the least virtual
+ * runtime in @p level is returned. Threads of processes that overran their
+ * quota are skipped. If no thread in @p level may run, NULL is returned
+ * instead.
+ */
+static struct thread *ready_fair(const struct ready_level *level)
+{
+    int best = -1;
+
+    for (unsigned i = 0; i < READY_MASK_LENGTH; i++) {
+        for (bitmap_t active = level->active[i]; active != 0;
+             active &= (active - 1)) {
+            const int pid = (i << BITMAP_WORD_SHIFT) + __builtin_ctz(active);
+            if (shares[pid].throttled) {
+                continue;
+            }
+            if ((best < 0) ||
+                (shares[pid].vruntime < shares[best].vruntime)) {
+                best = pid;
+            }
+        }
+    }
+
+    return ((best < 0) ? NULL : level->procs[best].head);
+}
+
+/**
+ * @brief Gets the next thread to run in the highest-priority ready queue of
+ * the underlying core that has a thread that may run.
+ *
+ * @details Real-time threads go first, by earliest deadline. Other threads are
+ * picked by fair share within their priority level.
+ *
+ * @returns A pointer to the next thread to run in the highest-priority ready
+ * queue of the underlying core that has a thread that may run is returned. If
+ * no ready thread of the underlying core may run, NULL is returned instead.
+ */
+static struct thread *ready_peek(void)
+{
+    const struct core_sched *core = core_sched();
+    struct thread *t = NULL;
+
+    if (core->rt.head != NULL) {
+        return (core->rt.head);
+    }
+
+    for (int prio = THREAD_PRIO_MAX; prio >= THREAD_PRIO_MIN; prio--) {
+        if ((t = ready_fair(&core->ready[prio])) != NULL) {
+            return (t);
+        }
+    }
+
+    return (NULL);
+}
+
+/**
+ * @brief Picks the next thread to run on the underlying core.
+ *
+ * @details This works like `ready_peek()`, but under address space affinity a
+ * thread of the process whose address space is loaded is preferred over the
+ * thread that fair share picks within the same priority. The thread that fair
+ * share picks is passed over at most `affinity_bound` times in a row.
+ *
+ * @returns A pointer to the next thread to run is returned. If no ready thread
+ * of the underlying core may run, NULL is returned instead.
+ */
+static struct thread *ready_pick(void)
+{
+    struct core_sched *core = core_sched();
+    struct thread *next = ready_peek();
+    struct thread *near = NULL;
+
+    if ((next != NULL) && (affinity_bound > 0) && !thread_is_rt(next) &&
+        (next->pid != core->as_pid) && (core->affinity_run < affinity_bound) &&
+        !shares[core->as_pid].throttled) {
+        near = core->ready[next->prio].procs[core->as_pid].head;
+    }
+
+    if (near != NULL) {
+        core->affinity_run++;
+        next = near;
+    } else {
+        core->affinity_run = 0;
+    }
+
+    // Keep track of the least virtual runtime.
+    if ((next != NULL) && !thread_is_rt(next) &&
+        (shares[next->pid].vruntime > share_floor)) {
+        share_floor = shares[next->pid].vruntime;
+    }
+
+    return (next);
+}
+
+/**
+ * @brief Checks if a thread should run ahead of another one.
+ *
+ * @param t    Target thread.
+ * @param curr Running thread.
+ *
+ * @returns If @p t should preempt @p curr, true is returned. Otherwise, false
+ * is returned instead.
+ */
+static bool thread_preempts(const struct thread *t, const struct thread *curr)
+{
+    if (thread_is_rt(t) != thread_is_rt(curr)) {
+        return (thread_is_rt(t));
+    }
+
+    if (thread_is_rt(t)) {
+        return (t->rt_deadline < curr->rt_deadline);
+    }
+
+    return (t->prio > curr->prio);
+}
+
+/**
+ * @brief Steals a ready thread from another core.
+ *
+ * @details The victim is the core with the most ready threads, and the stolen
+ * thread is the last one of the process with the most virtual runtime in its
+ * highest-priority non-empty priority level, which is one that would run last
+ * there. Real-time threads are stolen first. The stolen thread is moved to the
+ * ready queue of the underlying core.
+ *
+ * @returns Upon successful completion, a pointer to the stolen thread is
+ * returned. If no other core has ready threads, NULL is returned instead.
+ */
+static struct thread *thread_steal(void)
+{
+    const unsigned coreid = core_get_id();
+    struct core_sched *victim = NULL;
+
+    for (unsigned i = 0; i < KERNEL_CORES_MAX; i++) {
+        if ((i != coreid) && (cores[i].nready > 0) &&
+            ((victim == NULL) || (cores[i].nready > victim->nready))) {
+            victim = &cores[i];
+        }
+    }
+
+    if (victim == NULL) {
+        return (NULL);
+    }
+
+    // Steal real-time threads first. Threads of processes that overran their
+    // quota are left behind.
+    struct thread *t = victim->rt.tail;
+    for (int prio = THREAD_PRIO_MAX; (t == NULL) && (prio >= THREAD_PRIO_MIN);
+         prio--) {
+        const struct ready_level *level = &victim->ready[prio];
+        for (unsigned i = 0; i < READY_MASK_LENGTH; i++) {
+            for (bitmap_t active = level->active[i]; active != 0;
+                 active &= (active - 1)) {
+                const int pid =
+                    (i << BITMAP_WORD_SHIFT) + __builtin_ctz(active);
+                if (!shares[pid].throttled &&
+                    ((t == NULL) ||
+                     (shares[pid].vruntime > shares[t->pid].vruntime))) {
+                    t = level->procs[pid].tail;
+                }
+            }
+        }
+    }
+
+    if (t == NULL) {
+        return (NULL);
+    }
+
+    ready_remove(t);
+    t->core = coreid;
+    ready_push(t);
+
+    return (t);
+}
+
+/**
+ * @brief Changes the effective priority of a thread.
+ *
+ * @details If the target thread is ready, it is moved to the tail of the ready
+ * queue of its new priority level.
+ *
+ * @param t    Target thread.
+ * @param prio New effective priority.
+ */
+static void thread_set_prio(struct thread *t, int prio)
+{
+    if (t->prio == prio) {
+        return;
+    }
+
+    if (t->state == THREAD_READY) {
+        ready_remove(t);
+        t->prio = prio;
+        ready_push(t);
+    } else {
+        t->prio = prio;
+    }
+}
+
+/**
+ * @brief Checks if a thread ID refers to a thread that is in use.
+ *
+ * @param tid Target thread ID.
+ *
+ * @returns If @p tid refers to a thread that is in use, true is returned.
+ * Otherwise, false is returned instead.
+ */
+static bool thread_is_valid(tid_t tid)
+{
+    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (false);
+    }
+
+    return ((threads[tid] != NULL) &&
+            (threads[tid]->state != THREAD_TERMINATED));
+}
+
+/**
+ * @brief Wakes up a thread whose sleep timed out.
+ *
+ * @param arg Target thread.
+ */
+static void thread_timeout(void *arg)
+{
+    struct thread *t = arg;
+
+    t->timedout = true;
+    cond_leave(t);
+    thread_wakeup(t->tid);
+}
+
+/**
+ * @brief Gets the density of a real-time thread.
+ *
+ * @param params Real-time parameters of the target thread.
+ *
+ * @returns The density of the target thread, rounded up.
+ */
+static unsigned thread_rt_density(const struct thread_rt *params)
+{
+    return (((params->budget * THREAD_RT_DENSITY_SCALE) + params->deadline -
+             1) /
+            params->deadline);
+}
+
+/**
+ * @brief Handles the period timer of a real-time thread.
+ *
+ * @details The period timer goes off at the deadline of the target thread,
+ * and at the start of its next period. A deadline is missed if the target
+ * thread is still runnable and it has not given up the processor on its own
+ * since its period started. At the start of the next period, the budget of the
+ * target thread is replenished, and periods that went by meanwhile are
+ * skipped.
+ *
+ * @param arg Target thread.
+ */
+static void thread_rt_timer(void *arg)
+{
+    struct thread *t = arg;
+    const uint64_t now = interrupts_get_ticks();
+    const bool runnable =
+        (t->state == THREAD_READY) || (t->state == THREAD_RUNNING);
+
+    if (!t->rt_checked && (now >= t->rt_deadline)) {
+        t->rt_checked = true;
+        if (runnable && !t->rt_done) {
+            t->stats.misses++;
+        }
+    }
+
+    if (now >= (t->rt_release + t->rt.period)) {
+        if (t->state == THREAD_READY) {
+            ready_remove(t);
+        }
+
+        // Skip periods that went by meanwhile. The period timer goes off in
+        // every period, thus only a few are skipped, and no 64-bit division,
+        // which the kernel has no support for, is needed.
+        while (now >= (t->rt_release + t->rt.period)) {
+            t->rt_release += t->rt.period;
+        }
+        t->rt_deadline = t->rt_release + t->rt.deadline;
+        t->rt_used = 0;
+        t->rt_throttled = false;
+        t->rt_done = false;
+        t->rt_checked = false;
+
+        if (t->state == THREAD_READY) {
+            ready_push(t);
+        }
+    }
+
+    const uint64_t next =
+        t->rt_checked ? (t->rt_release + t->rt.period) : t->rt_deadline;
+    timeout_set(&t->rt_timer, (next > now) ? (unsigned)(next - now) : 0);
+}
+
+/**
+ * @brief Moves a thread to the real-time class.
+ *
+ * @details The first period of the target thread starts right away.
+ *
+ * @param t      Target thread.
+ * @param params Real-time parameters.
+ */
+static void thread_rt_enter(struct thread *t, const struct thread_rt *params)
+{
+    const bool queued = (t->state == THREAD_READY);
+
+    if (queued) {
+        ready_remove(t);
+    }
+
+    __memcpy(&t->rt, params, sizeof(struct thread_rt));
+    rt_density += thread_rt_density(&t->rt);
+    t->rt_release = interrupts_get_ticks();
+    t->rt_deadline = t->rt_release + t->rt.deadline;
+    t->rt_used = 0;
+    t->rt_throttled = false;
+    t->rt_done = false;
+    t->rt_checked = false;
+    timeout_set(&t->rt_timer, t->rt.deadline);
+
+    if (queued) {
+        ready_push(t);
+    }
+}
+
+/**
+ * @brief Moves a thread back to the regular scheduling class.
+ *
+ * @details This function does nothing if the target thread is not a real-time
+ * thread.
+ *
+ * @param t Target thread.
+ */
+static void thread_rt_leave(struct thread *t)
+{
+    const bool queued = (t->state == THREAD_READY);
+
+    if (!thread_is_rt(t)) {
+        return;
+    }
+
+    if (queued) {
+        ready_remove(t);
+    }
+
+    timeout_clear(&t->rt_timer);
+    rt_density -= thread_rt_density(&t->rt);
+    __memset(&t->rt, 0, sizeof(struct thread_rt));
+    t->rt_throttled = false;
+
+    if (queued) {
+        ready_push(t);
+    }
+}
+
+/**
+ * @brief Allocates a thread control block and a thread ID.
+ *
+ * @details The thread is assigned to the underlying core.
+ *
+ * @returns Upon successful completion, a pointer to the allocated thread
+ * control block is returned. Upon failure, NULL is returned instead.
+ */
+static struct thread *thread_alloc(void)
+{
+    // No thread ID is available.
+    if (free_tids.head == free_tids.tail) {
+        return (NULL);
+    }
+
+    struct thread *t = kcache_alloc(&thread_cache);
+    if (t == NULL) {
+        return (NULL);
+    }
+
+    t->tid = free_tids.tids[free_tids.head++ & (THREADS_MAX - 1)];
+    t->state = THREAD_STARTED;
+    t->core = core_get_id();
+    t->killed = false;
+    __memset(&t->stats, 0, sizeof(struct thread_stats));
+    t->stamp = cpu_cycles();
+    t->ready_stamp = t->stamp;
+    t->kdepth = 0;
+    t->tls = 0;
+    timeout_init(&t->timeout, thread_timeout, t);
+    t->timedout = false;
+    __memset(&t->rt, 0, sizeof(struct thread_rt));
+    t->rt_throttled = false;
+    timeout_init(&t->rt_timer, thread_rt_timer, t);
+    threads[t->tid] = t;
+
+    return (t);
+}
+
+/**
+ * @brief Releases the control block of a thread that was released before on
+ * the underlying core.
+ */
+static void thread_reap(void)
+{
+    struct core_sched *core = core_sched();
+
+    if ((core->zombie != NULL) && (core->zombie != core->running)) {
+        KASSERT(kcache_free(&thread_cache, core->zombie) == 0);
+        core->zombie = NULL;
+    }
+}
+
+/**
+ * @brief Releases a thread control block and its thread ID.
+ *
+ * @details The control block of the running thread is needed until it
+ * switches out, thus it is actually released on a later context switch.
+ *
+ * @param t Target thread.
+ */
+static void thread_release(struct thread *t)
+{
+    threads[t->tid] = NULL;
+    free_tids.tids[free_tids.tail++ & (THREADS_MAX - 1)] = t->tid;
+
+    if (t == thread_running()) {
+        thread_reap();
+        core_sched()->zombie = t;
+    } else {
+        KASSERT(kcache_free(&thread_cache, t) == 0);
+    }
+}
+
+/**
+ * @brief Ends the time slice of a thread.
+ *
+ * @details Under the adaptive policy, a thread whose time slice expired gets
+ * a time slice twice as long, and a thread that blocked before its time slice
+ * expired gets a time slice half as long.
+ *
+ * @param t       Target thread.
+ * @param expired Did the time slice expire?
+ */
+static void thread_slice_end(struct thread *t, bool expired)
+{
+    if (expired) {
+        t->expired++;
+    }
+
+    if (!t->adaptive) {
+        return;
+    }
+
+    if (expired) {
+        t->slice = ((2 * t->slice) < THREAD_QUANTUM_MAX) ? (2 * t->slice)
+                                                         : THREAD_QUANTUM_MAX;
+    } else {
+        t->slice = ((t->slice / 2) > THREAD_QUANTUM_MIN) ? (t->slice / 2)
+                                                         : THREAD_QUANTUM_MIN;
+    }
+}
+
+/**
+ * @brief Adds up thread statistics.
+ *
+ * @param dst Target statistics.
+ * @param src Statistics to add to @p dst.
+ */
+static void thread_stats_add(struct thread_stats *dst,
+                             const struct thread_stats *src)
+{
+    dst->user_cycles += src->user_cycles;
+    dst->kernel_cycles += src->kernel_cycles;
+    dst->ready_cycles += src->ready_cycles;
+    dst->idle_cycles += src->idle_cycles;
+    dst->nvcsw += src->nvcsw;
+    dst->nivcsw += src->nivcsw;
+    dst->misses += src->misses;
+    dst->throttles += src->throttles;
+    dst->as_same += src->as_same;
+    dst->as_cross += src->as_cross;
+}
+
+/**
+ * @brief Charges a running thread for the time it used since its last
+ * accounting event.
+ *
+ * @details The process of a thread in the regular class also accrues virtual
+ * runtime, at a rate inversely proportional to its weight.
+ *
+ * @param t   Target thread.
+ * @param now Current cycle count.
+ */
+static void thread_account(struct thread *t, uint64_t now)
+{
+    const uint64_t cycles = now - t->stamp;
+
+    t->stamp = now;
+
+    if (t == cores[t->core].idle) {
+        t->stats.idle_cycles += cycles;
+    } else if ((t->kdepth > 0) || (t->pid == KERNEL_PROCESS)) {
+        t->stats.kernel_cycles += cycles;
+    } else {
+        t->stats.user_cycles += cycles;
+    }
+
+    if ((t->pid != KERNEL_PROCESS) && !thread_is_rt(t)) {
+        shares[t->pid].vruntime +=
+            (cycles * shares[t->pid].rate) >> SHARE_RATE_SHIFT;
+    }
+}
+
+/**
+ * @brief Takes the running thread off the underlying core.
+ *
+ * @details A running thread is put back in the ready queue. A thread that
+ * blocked or terminated before its time slice expired has its time slice ended.
+ * The idle thread is never queued.
+ */
+static void thread_deschedule(void)
+{
+    const struct core_sched *core = core_sched();
+    struct thread *curr = core->running;
+
+    if (curr == core->idle) {
+        return;
+    }
+
+    if (curr->state == THREAD_RUNNING) {
+        thread_set_state(curr, THREAD_READY);
+    } else if (curr->quantum < curr->slice) {
+        // Running thread blocked before its time slice expired.
+        thread_slice_end(curr, false);
+    }
+}
+
+/**
+ * @brief Switches the underlying core to a thread.
+ *
+ * @details The kernel lock is carried across the switch: the target thread
+ * resumes at the depth that it held when it switched out.
+ *
+ * @param next    Target thread. It should be ready.
+ * @param quantum Number of ticks that count as already used in the time slice
+ *                of @p next.
+ */
+static void thread_switch(struct thread *next, unsigned quantum)
+{
+    struct core_sched *core = core_sched();
+    struct thread *prev = core->running;
+    const uint64_t now = cpu_cycles();
+
+    thread_account(prev, now);
+    if (prev != next) {
+        if (core->preempt) {
+            prev->stats.nivcsw++;
+        } else {
+            // A real-time thread is done with its job once it gives up the
+            // processor on its own.
+            prev->stats.nvcsw++;
+            prev->rt_done = true;
+        }
+        if (context_switches_pgdir(&next->ctx)) {
+            next->stats.as_cross++;
+        } else {
+            next->stats.as_same++;
+        }
+    }
+    core->preempt = false;
+
+    core->running = next;
+    if (next->pid != KERNEL_PROCESS) {
+        core->as_pid = next->pid;
+    }
+    next->quantum = quantum;
+    next->slices++;
+    thread_set_state(next, THREAD_RUNNING);
+    next->core = core_get_id();
+    next->stamp = now;
+
+    kinfo_switch(next->tid, next->pid);
+    fpu_switch(&next->fpu);
+    gdt_tls_switch(next->tls);
+
+    const unsigned depth = klock_save();
+    __context_switch(&prev->ctx, &next->ctx);
+    klock_restore(depth);
+}
+
+/**
+ * @brief Hands the underlying core over to a thread, bypassing the scheduling
+ * policy.
+ *
+ * @details The target thread runs for what is left of the time slice of the
+ * running thread, but never for longer than its own time slice. A real-time
+ * thread that overran its budget waits for its next period instead.
+ *
+ * @param next Target thread. It should be ready.
+ */
+static void thread_handoff(struct thread *next)
+{
+    const struct thread *curr = thread_running();
+    const unsigned remaining =
+        (curr->quantum < curr->slice) ? (curr->slice - curr->quantum) : 0;
+
+    if (next->rt_throttled || thread_is_capped(next)) {
+        thread_yield();
+        return;
+    }
+
+    thread_reap();
+    thread_deschedule();
+
+    thread_switch(next,
+                  (remaining < next->slice) ? (next->slice - remaining) : 0);
+}
+
+/**
+ * @details Handles a timer interrupt. Every core runs this on each timer tick,
+ * but only the master core keeps the tick count.
+ */
+static void do_timer(void)
+{
+    struct core_sched *core = core_sched();
+    struct thread *curr = core->running;
+
+    if (core_get_id() == CORE_MASTER) {
+        kinfo_tick();
+        timeout_expire(interrupts_get_ticks());
+    }
+
+    // Do not preempt the idle thread.
+    if (curr == core->idle) {
+        return;
+    }
+
+    // Another core released or put the running thread to sleep meanwhile.
+    thread_check_killed();
+    if (curr->state != THREAD_RUNNING) {
+        thread_yield();
+        return;
+    }
+
+    // Keep virtual runtime up to date.
+    thread_account(curr, cpu_cycles());
+
+    struct thread *next = ready_peek();
+
+    if (thread_is_rt(curr)) {
+        // Throttle the running thread if it overran its budget.
+        if (++curr->rt_used >= curr->rt.budget) {
+            curr->rt_throttled = true;
+            curr->stats.throttles++;
+            core->preempt = true;
+            thread_yield();
+            return;
+        }
+    } else if (share_charge(curr)) {
+        // Throttle the running thread if its process overran its quota.
+        curr->stats.throttles++;
+        core->preempt = true;
+        thread_yield();
+        return;
+    } else if (++curr->quantum >= curr->slice) {
+        // Preempt the running thread if its time slice expired.
+        thread_slice_end(curr, true);
+        core->preempt = true;
+        thread_yield();
+        return;
+    }
+
+    // Preempt the running thread if a thread that goes first is ready.
+    if ((next != NULL) && thread_preempts(next, curr)) {
+        core->preempt = true;
+        thread_yield();
+    }
+}
+
+/**
+ * @brief Idle loop of a core.
+ *
+ * @details Each core has an idle thread that runs this loop whenever no thread
+ * is ready on that core. Ready threads are stolen from other cores, if any. The
+ * kernel lock is released while the core idles, at most until the next
+ * timeout expires. If more than one core is online, threads that become ready
+ * on an idle core wait for its next timer tick.
+ */
+static noreturn void thread_idle(void)
+{
+    struct thread *next = NULL;
+
+    // Start with a single level of the kernel lock.
+    klock_restore(1);
+
+    while (true) {
+        thread_reap();
+        timeout_expire(interrupts_get_ticks());
+
+        if (((next = ready_pick()) != NULL) ||
+            ((next = thread_steal()) != NULL)) {
+            thread_switch(next, 0);
+            continue;
+        }
+
+        klock_restore(0);
+        interrupts_idle(timeout_next());
+        klock_restore(1);
+    }
+}
+
+/**
+ * @brief Entry point of kernel threads.
+ *
+ * @details Runs the routine of the underlying kernel thread.
+ */
+static noreturn void thread_kernel_start(void)
+{
+    // Start with a single level of the kernel lock.
+    klock_restore(1);
+
+    ((void (*)(void))thread_running()->start)();
+
+    UNREACHABLE();
+}
+
+/**
+ * @brief Allocates a kernel thread.
+ *
+ * @details The kernel thread belongs to the kernel process and it is left in
+ * the started state. It has no address space of its own, thus it borrows that
+ * of the thread that ran before it.
+ *
+ * @param entry Entry point of the kernel thread.
+ * @param prio  Priority of the kernel thread.
+ *
+ * @returns Upon successful completion, a pointer to the kernel thread is
+ * returned. Upon failure, NULL is returned instead.
+ */
+static struct thread *thread_kernel_alloc(void (*entry)(void), int prio)
+{
+    struct thread *t = thread_alloc();
+    if (t == NULL) {
+        return (NULL);
+    }
+
+    t->pid = KERNEL_PROCESS;
+    t->quantum = 0;
+    t->slice = THREAD_QUANTUM_DEFAULT;
+    t->adaptive = false;
+    t->slices = 0;
+    t->expired = 0;
+    t->prio = prio;
+    t->baseprio = prio;
+    t->start = NULL;
+    t->args = NULL;
+    t->retval = NULL;
+    t->ustack = NULL;
+    t->ustack_size = 0;
+    t->ustack_low = NULL;
+    t->detached = false;
+    t->prev = NULL;
+    t->next = NULL;
+    t->wchan = NULL;
+    t->wnext = NULL;
+    t->held = NULL;
+    cond_init(&t->joiners);
+
+    t->kstack = kpage_get(true);
+    if (t->kstack == NULL) {
+        thread_release(t);
+        return (NULL);
+    }
+
+    void *ksp = context_forge_stack(t->kstack, entry);
+    KASSERT(ksp != NULL);
+
+    // Borrow the address space of the previous thread.
+    KASSERT(context_create(&t->ctx,
+                           NULL,
+                           (const void *)(t->kstack + PAGE_SIZE),
+                           ksp) == 0);
+    fpu_state_init(&t->fpu);
+
+    return (t);
+}
+
+/**
+ * @brief Creates the idle thread of the underlying core.
+ *
+ * @details The idle thread is always in the running state, and it is never
+ * queued.
+ *
+ * @returns A pointer to the idle thread of the underlying core.
+ */
+static struct thread *thread_idle_create(void)
+{
+    struct thread *t = thread_kernel_alloc(thread_idle, THREAD_PRIO_MIN);
+    KASSERT(t != NULL);
+
+    t->state = THREAD_RUNNING;
+
+    return (t);
+}
+
+/**
+ * @brief Checks if some thread of a process is running on another core.
+ *
+ * @param pid Target process ID.
+ *
+ * @returns If some thread of the process @p pid is running on a core other
+ * than the underlying one, true is returned. Otherwise, false is returned
+ * instead.
+ */
+static bool thread_any_remote(pid_t pid)
+{
+    const unsigned coreid = core_get_id();
+
+    for (unsigned i = 0; i < KERNEL_CORES_MAX; i++) {
+        if ((i != coreid) && (cores[i].running != NULL) &&
+            (cores[i].running->pid == pid)) {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/**
+ * @brief Releases the pages of a user stack below some address.
+ *
+ * @param p          Owner process.
+ * @param ustack_low Lowest mapped page of the user stack.
+ * @param limit      Lowest address of the user stack that is kept.
+ *
+ * @returns The lowest mapped page of the user stack that is left.
+ */
+static byte_t *stack_trim(struct process *p, byte_t *ustack_low, vaddr_t limit)
+{
+    struct pde *pgdir = (struct pde *)vmem_pgdir_get(p->vmem);
+
+    while (VADDR(ustack_low) < limit) {
+        KASSERT(upage_free(pgdir, VADDR(ustack_low)) == 0);
+        ustack_low += PAGE_SIZE;
+    }
+
+    return (ustack_low);
+}
+
+/**
+ * @brief Releases a kernel stack and a user stack.
+ *
+ * @param p          Owner process.
+ * @param kstack     Kernel stack.
+ * @param ustack     User stack (top).
+ * @param ustack_low Lowest mapped page of the user stack.
+ */
+static void stack_release(struct process *p, byte_t *kstack, byte_t *ustack,
+                          byte_t *ustack_low)
+{
+    KASSERT(kpage_put(kstack) == 0);
+
+    // Release pages that the user stack grew into.
+    stack_trim(p, ustack_low, VADDR(ustack));
+
+    int pos = (USER_END_VIRT - VADDR(ustack)) / USER_STACK_REGION_SIZE;
+    bitmap_clear(&p->ustackmap, pos);
+}
+
+/**
+ * @brief Puts the stacks of a thread in the cache of its process.
+ *
+ * @details The user stack keeps at most THREAD_STACK_CACHE_PAGES pages mapped.
+ * If the cache is full, the stacks are released instead.
+ *
+ * @param p Owner process.
+ * @param t Target thread.
+ */
+static void stack_cache_put(struct process *p, const struct thread *t)
+{
+    struct stack_cache *cache = &stack_caches[p->pid];
+
+    if (cache->count == THREAD_STACK_CACHE_MAX) {
+        stack_release(p, t->kstack, t->ustack, t->ustack_low);
+        return;
+    }
+
+    const vaddr_t limit =
+        VADDR(t->ustack) - (THREAD_STACK_CACHE_PAGES * PAGE_SIZE);
+
+    cache->stacks[cache->count].kstack = t->kstack;
+    cache->stacks[cache->count].ustack = t->ustack;
+    cache->stacks[cache->count].ustack_low =
+        stack_trim(p, t->ustack_low, limit);
+    cache->count++;
+}
+
+/**
+ * @brief Takes the warmest stacks out of the cache of a process.
+ *
+ * @details User stack pages that lie beyond the size of the user stack of the
+ * target thread are released, so that the guard of the user stack still
+ * works.
+ *
+ * @param p Owner process.
+ * @param t Target thread. Its user stack size should be set.
+ *
+ * @returns If a kernel stack and a user stack were assigned to @p t, true is
+ * returned. If the cache is empty, false is returned instead.
+ */
+static bool stack_cache_get(struct process *p, struct thread *t)
+{
+    struct stack_cache *cache = &stack_caches[p->pid];
+
+    if (cache->count == 0) {
+        return (false);
+    }
+
+    cache->count--;
+    t->kstack = cache->stacks[cache->count].kstack;
+    t->ustack = cache->stacks[cache->count].ustack;
+    t->ustack_low = stack_trim(p,
+                               cache->stacks[cache->count].ustack_low,
+                               VADDR(t->ustack) - t->ustack_size);
+
+    return (true);
+}
+
+/**
+ * @brief Releases all stacks in the cache of a process.
+ *
+ * @param p Owner process.
+ */
+static void stack_cache_flush(struct process *p)
+{
+    struct stack_cache *cache = &stack_caches[p->pid];
+
+    while (cache->count > 0) {
+        cache->count--;
+        stack_release(p,
+                      cache->stacks[cache->count].kstack,
+                      cache->stacks[cache->count].ustack,
+                      cache->stacks[cache->count].ustack_low);
+    }
+}
+
+/**
+ * @brief Releases the memory used by a thread.
+ *
+ * @details Stacks of user threads are put in the cache of their process.
+ *
+ * @param t Target thread.
+ */
+static void thread_free_memory(struct thread *t)
+{
+    KASSERT(t != NULL);
+
+    if (t->ustack != NULL) {
+        KASSERT(kpool_is_kpage(VADDR(t->kstack)));
+        stack_cache_put(process_get(t->pid), t);
+    } else if (kpool_is_kpage(VADDR(t->kstack))) {
+        KASSERT(kpage_put(t->kstack) == 0);
+    }
+
+    t->kstack = NULL;
+    t->ustack = NULL;
+    t->ustack_size = 0;
+    t->ustack_low = NULL;
+}
+
+/**
+ * @brief Grows the user stack of a thread down to a faulting address.
+ *
+ * @details Every page between the lowest mapped page of the user stack and the
+ * faulting address is mapped, so that mapped pages stay contiguous.
+ *
+ * @param t    Target thread.
+ * @param addr Faulting address.
+ *
+ * @returns Upon successful completion, zero is returned. If @p addr does not
+ * lie in the unmapped part of the user stack of @p t, -EFAULT is returned. If
+ * there is no memory left, -ENOMEM is returned.
+ */
+static int thread_stack_grow(struct thread *t, vaddr_t addr)
+{
+    if (t->ustack == NULL) {
+        return (-EFAULT);
+    }
+
+    const vaddr_t bottom = VADDR(t->ustack) - t->ustack_size;
+    if (!WITHIN(addr, bottom, VADDR(t->ustack_low))) {
+        return (-EFAULT);
+    }
+
+    struct process *p = process_get(t->pid);
+    struct pde *pgdir = (struct pde *)vmem_pgdir_get(p->vmem);
+
+    while (VADDR(t->ustack_low) > ALIGN(addr, PAGE_SIZE)) {
+        const vaddr_t page = VADDR(t->ustack_low) - PAGE_SIZE;
+        if (upage_alloc(pgdir, page, true, false) != 0) {
+            return (-ENOMEM);
+        }
+        t->ustack_low = (byte_t *)page;
+    }
+
+    return (0);
+}
+
+/**
+ * @brief Handles a page fault.
+ *
+ * @details Faults on the user stack of the running thread grow it. A thread
+ * that overflows its user stack, either by touching its guard page or by
+ * running out of memory, is terminated. Any other fault is fatal.
+ *
+ * @param excp Exception information.
+ * @param ctx  Interrupted context.
+ */
+static void do_page_fault(const struct exception *excp,
+                          const struct context *ctx)
+{
+    const vaddr_t addr = exception_get_addr(excp);
+    struct thread *curr = thread_running();
+
+    const int ret = thread_stack_grow(curr, addr);
+    if (ret == 0) {
+        return;
+    }
+
+    if (curr->ustack != NULL) {
+        const vaddr_t guard =
+            VADDR(curr->ustack) - curr->ustack_size - PAGE_SIZE;
+
+        if ((ret == -ENOMEM) || WITHIN(addr, guard, guard + PAGE_SIZE)) {
+            log(WARN, "thread %d overflowed its user stack", curr->tid);
+            thread_exit(NULL);
+        }
+    }
+
+    context_dump(ctx);
+    exception_dump(excp);
+    kpanic("[pm] page fault at %x", addr);
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Initializes the thread system.
+ */
+void thread_init(void)
+{
+    // Sanity check sizes.
+    KASSERT_SIZE(sizeof(struct thread_quantum), __SIZEOF_THREAD_QUANTUM);
+    KASSERT_SIZE(sizeof(struct thread_stats), __SIZEOF_THREAD_STATS);
+    KASSERT_SIZE(sizeof(struct thread_rt), __SIZEOF_THREAD_RT);
+    KASSERT_SIZE(sizeof(struct thread_share), __SIZEOF_THREAD_SHARE);
+
+    // Initializes the cache of thread control blocks.
+    KASSERT(kcache_init(&thread_cache,
+                        "thread",
+                        sizeof(struct thread),
+                        _Alignof(struct thread)) == 0);
+
+    timeout_wheel_init();
+
+    // Initializes fair share state.
+    for (pid_t pid = 0; pid < PROCESS_MAX; pid++) {
+        timeout_init(&shares[pid].timer, share_timer, &shares[pid]);
+        share_reset(pid);
+    }
+
+    // Initializes the thread index. The kernel thread ID is never released.
+    for (tid_t tid = 0; tid < THREADS_MAX; tid++) {
+        threads[tid] = NULL;
+        if (tid != KERNEL_THREAD) {
+            free_tids.tids[free_tids.tail++ & (THREADS_MAX - 1)] = tid;
+        }
+    }
+
+    for (unsigned i = 0; i < KERNEL_CORES_MAX; i++) {
+        cores[i].idle = NULL;
+        cores[i].zombie = NULL;
+        cores[i].nready = 0;
+        cores[i].preempt = false;
+        cores[i].as_pid = KERNEL_PROCESS;
+        cores[i].affinity_run = 0;
+        cores[i].rt.head = NULL;
+        cores[i].rt.tail = NULL;
+        for (int prio = THREAD_PRIO_MIN; prio <= THREAD_PRIO_MAX; prio++) {
+            for (unsigned j = 0; j < READY_MASK_LENGTH; j++) {
+                cores[i].ready[prio].active[j] = 0;
+            }
+            for (pid_t pid = 0; pid < PROCESS_MAX; pid++) {
+                cores[i].ready[prio].procs[pid].head = NULL;
+                cores[i].ready[prio].procs[pid].tail = NULL;
+            }
+        }
+    }
+
+    // The kernel main thread borrows address spaces, like idle threads do.
+    __memset(&kernel_thread.ctx, 0, sizeof(struct context));
+    kernel_thread.tid = KERNEL_THREAD;
+    kernel_thread.state = THREAD_RUNNING;
+    kernel_thread.quantum = 0;
+    kernel_thread.slice = THREAD_QUANTUM_DEFAULT;
+    kernel_thread.adaptive = false;
+    kernel_thread.slices = 0;
+    kernel_thread.expired = 0;
+    kernel_thread.prio = THREAD_PRIO_DEFAULT;
+    kernel_thread.baseprio = THREAD_PRIO_DEFAULT;
+    kernel_thread.held = NULL;
+    kernel_thread.pid = KERNEL_PROCESS;
+    kernel_thread.core = CORE_MASTER;
+    kernel_thread.killed = false;
+    __memset(&kernel_thread.stats, 0, sizeof(struct thread_stats));
+    kernel_thread.stamp = cpu_cycles();
+    kernel_thread.ready_stamp = kernel_thread.stamp;
+    kernel_thread.kdepth = 0;
+    kernel_thread.tls = 0;
+    timeout_init(&kernel_thread.timeout, thread_timeout, &kernel_thread);
+    kernel_thread.timedout = false;
+    __memset(&kernel_thread.rt, 0, sizeof(struct thread_rt));
+    kernel_thread.rt_throttled = false;
+    timeout_init(&kernel_thread.rt_timer, thread_rt_timer, &kernel_thread);
+    kernel_thread.kstack = NULL;
+    kernel_thread.ustack = NULL;
+    kernel_thread.prev = NULL;
+    kernel_thread.next = NULL;
+    kernel_thread.wchan = NULL;
+    kernel_thread.wnext = NULL;
+    cond_init(&kernel_thread.joiners);
+    fpu_state_init(&kernel_thread.fpu);
+    threads[KERNEL_THREAD] = &kernel_thread;
+
+    cores[CORE_MASTER].idle = thread_idle_create();
+
+    interrupt_register(INTERRUPT_TIMER, do_timer);
+    KASSERT(exception_register(EXCEPTION_PAGE_FAULT, do_page_fault) == 0);
+}
+
+/**
+ * @details Creates a new thread.
+ */
+tid_t thread_create(struct process *p, void *(*start)(), void *args,
+                    void (*caller)(void), size_t stacksize)
+{
+    struct thread *t;
+
+    // Use the default stack size, if none is given.
+    if (stacksize == 0) {
+        stacksize = THREAD_STACK_SIZE_DEFAULT;
+    }
+
+    // Check for invalid stack size.
+    if (stacksize > THREAD_STACK_SIZE_MAX) {
+        goto error0;
+    }
+
+    if ((p == NULL) || (process_is_valid(p->pid) != 0) || (start == NULL) ||
+        (t = thread_alloc()) == NULL) {
+        goto error0;
+    }
+
+    // Initializes basic TBC info.
+    t->pid = p->pid;
+    t->quantum = 0;
+    t->slice = THREAD_QUANTUM_DEFAULT;
+    t->adaptive = false;
+    t->slices = 0;
+    t->expired = 0;
+    t->prio = THREAD_PRIO_DEFAULT;
+    t->baseprio = THREAD_PRIO_DEFAULT;
+    t->start = start;
+    t->args = args;
+    t->retval = NULL;
+    t->prev = NULL;
+    t->next = NULL;
+    t->wchan = NULL;
+    t->wnext = NULL;
+    t->held = NULL;
+    cond_init(&t->joiners);
+
+    t->ustack_size = TRUNCATE(stacksize, PAGE_SIZE);
+
+    // Reuses warm stacks of a thread that exited, if any.
+    if (!stack_cache_get(p, t)) {
+        // Allocates thread's kernel stack. It is not cleaned, because only the
+        // forged interrupt stack is read.
+        void *kstack = kpage_get(false);
+        if (kstack == NULL) {
+            goto error1;
+        }
+        t->kstack = kstack;
+
+        // Checks if the owner process has memory avaible for a new thread.
+        bitmap_t fbit = bitmap_first_free(&p->ustackmap, 0, sizeof(bitmap_t));
+        if (fbit >= THREAD_USTACK_MAX) {
+            kpage_put(kstack);
+            goto error1;
+        }
+
+        // Reserves a region of the user stack area. Pages are mapped as the
+        // stack grows into them.
+        bitmap_set(&p->ustackmap, fbit);
+        t->ustack =
+            (byte_t *)(USER_END_VIRT - (fbit * USER_STACK_REGION_SIZE));
+        t->ustack_low = t->ustack;
+    }
+
+    void *ksp = NULL;
+    if ((word_t)t->start == USER_BASE_VIRT) {
+        // Forges root thread. Its first stack page is mapped on demand, in its
+        // own virtual memory space.
+        ksp = interrupt_forge_stack(t->ustack,
+                                    t->kstack,
+                                    (void (*)(void))t->start,
+                                    __do_process_setup);
+    } else {
+        // Sets up user-created stack. Its first page may be mapped already.
+        vaddr_t ubp = VADDR(t->ustack - PAGE_SIZE);
+        if (t->ustack_low == t->ustack) {
+            if (upage_alloc((struct pde *)vmem_pgdir_get(p->vmem),
+                            ubp,
+                            true,
+                            false) < 0) {
+                goto error2;
+            }
+            t->ustack_low = (byte_t *)ubp;
+        }
+
+        void *usp = uthread_forge_stack((void *)ubp, t->args, start);
+        KASSERT(usp != NULL);
+        ksp = interrupt_forge_stack(usp, t->kstack, caller, __start_uthread);
+    }
+    KASSERT(ksp != NULL);
+
+    // Creates initial thread context.
+    KASSERT(context_create(&t->ctx,
+                           vmem_pgdir_get(p->vmem),
+                           (const void *)(t->kstack + PAGE_SIZE),
+                           ksp) == 0);
+
+    fpu_state_init(&t->fpu);
+    thread_set_state(t, THREAD_READY);
+
+    return (t->tid);
+
+error2:
+    stack_release(p, t->kstack, t->ustack, t->ustack_low);
+error1:
+    thread_release(t);
+error0:
+    return (-1);
+}
+
+/**
+ * @details Creates a kernel thread that runs @p func, and puts it in the ready
+ * queue of the underlying core.
+ */
+tid_t thread_create_kernel(void (*func)(void))
+{
+    if (func == NULL) {
+        return (-EINVAL);
+    }
+
+    struct thread *t =
+        thread_kernel_alloc(thread_kernel_start, THREAD_PRIO_DEFAULT);
+    if (t == NULL) {
+        return (-EAGAIN);
+    }
+
+    t->start = (void *(*)())func;
+    thread_set_state(t, THREAD_READY);
+
+    return (t->tid);
+}
+
+/**
+ * @details Releases a thread entry.
+ */
+int thread_free(tid_t tid)
+{
+    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (-EINVAL);
+    }
+    struct thread *t = threads[tid];
+    if (t == NULL) {
+        return (-EINVAL);
+    }
+
+    // A thread that is running on another core is released by that core.
+    if (thread_is_remote(t)) {
+        t->killed = true;
+        cores_kick();
+        return (0);
+    }
+
+    // Keep the statistics of the target thread in its process.
+    if (t == thread_running()) {
+        thread_account(t, cpu_cycles());
+    }
+    thread_stats_add(&released_stats[t->pid], &t->stats);
+
+    // Drop any reference to the target thread.
+    thread_set_state(t, THREAD_AVAILABLE);
+    cond_leave(t);
+    semaphore_drop_held(t->tid);
+    timeout_clear(&t->timeout);
+    thread_rt_leave(t);
+    cond_broadcast(&t->joiners);
+
+    fpu_release(&t->fpu);
+    thread_free_memory(t);
+    thread_release(t);
+
+    return (0);
+}
+
+/**
+ * @details Releases all threads owned by the target process, along with the
+ * stacks that the target process has in cache.
+ */
+int thread_free_all(pid_t pid)
+{
+    if (pid == KERNEL_PROCESS || process_is_valid(pid) != 0) {
+        return (-EINVAL);
+    }
+
+    for (tid_t tid = 0; tid < THREADS_MAX; tid++) {
+        if ((threads[tid] != NULL) && (threads[tid]->pid == pid)) {
+            thread_free(tid);
+        }
+    }
+
+    // Wait for other cores to release the threads that they are running.
+    while (thread_any_remote(pid)) {
+        klock_relax();
+    }
+
+    stack_cache_flush(process_get(pid));
+    __memset(&released_stats[pid], 0, sizeof(struct thread_stats));
+    share_reset(pid);
+
+    return (0);
+}
+
+/**
+ * @details Releases the calling thread if another core released it while it
+ * was running. In this case, this function does not return.
+ */
+void thread_check_killed(void)
+{
+    struct thread *curr = thread_running();
+
+    if (curr->killed) {
+        KASSERT(thread_free(curr->tid) == 0);
+        thread_yield();
+        UNREACHABLE();
+    }
+}
+
+/**
+ * @details Runs the scheduler on an application core. The idle thread of the
+ * underlying core is created, and the boot context of the underlying core is
+ * discarded.
+ */
+noreturn void thread_core_start(void)
+{
+    struct core_sched *core = core_sched();
+    struct context boot;
+
+    core->idle = thread_idle_create();
+    core->running = core->idle;
+
+    __context_switch(&boot, &core->idle->ctx);
+    UNREACHABLE();
+}
+
+/**
+ * @details Gets the context of the target thread.
+ */
+struct context *thread_get_ctx(tid_t tid)
+{
+    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (NULL);
+    }
+
+    if (threads[tid] == NULL) {
+        return (NULL);
+    }
+
+    return (&threads[tid]->ctx);
+}
+
+/**
+ * @details Gets the thread identified by @p tid.
+ */
+struct thread *thread_get(tid_t tid)
+{
+    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (NULL);
+    }
+
+    return (threads[tid]);
+}
+
+/**
+ * @details Gets the thread that is running on the underlying core.
+ */
+tid_t thread_get_curr(void)
+{
+    return (thread_running()->tid);
+}
+
+/**
+ * @details Gets the Process ID of the target thread.
+ */
+pid_t thread_get_pid(tid_t tid)
+{
+    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid] == NULL) {
+        return (-EINVAL);
+    }
+
+    return (threads[tid]->pid);
+}
+
+/**
+ * @details Yields the CPU.
+ */
+void thread_yield(void)
+{
+    struct thread *next = NULL;
+
+    thread_reap();
+    thread_deschedule();
+
+    // Select the first thread with highest priority, or a thread that shares
+    // the loaded address space. Switch to the idle thread if no thread is
+    // ready.
+    if ((next = ready_pick()) == NULL) {
+        next = core_sched()->idle;
+    }
+
+    thread_switch(next, 0);
+}
+
+/**
+ * @details Hands the remainder of the time slice of the calling thread over
+ * to the thread identified by @p tid, bypassing the scheduling policy. If the
+ * target thread is not ready, the calling thread yields as usual instead.
+ */
+int thread_yield_to(tid_t tid)
+{
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
+    }
+
+    struct thread *t = threads[tid];
+
+    if (t == thread_running()) {
+        return (-EINVAL);
+    }
+
+    if (t->state != THREAD_READY) {
+        thread_yield();
+        return (-EAGAIN);
+    }
+
+    thread_handoff(t);
+
+    return (0);
+}
+
+/**
+ * @details This function puts the calling thread to sleep. The calling thread
+ * resumes its execution when another thread invokes `thread_wakeup()`.
+ */
+void thread_sleep(void)
+{
+    thread_set_state(thread_running(), THREAD_WAITING);
+    thread_yield();
+}
+
+/**
+ * @details This function puts the calling thread to sleep, like
+ * `thread_sleep()` does, and hands the remainder of its time slice over to the
+ * thread identified by @p tid, if that thread is ready.
+ */
+void thread_sleep_to(tid_t tid)
+{
+    thread_set_state(thread_running(), THREAD_WAITING);
+
+    if (thread_is_valid(tid) && (threads[tid]->state == THREAD_READY)) {
+        thread_handoff(threads[tid]);
+    } else {
+        thread_yield();
+    }
+}
+
+/**
+ * @details This function puts the calling thread to sleep, like
+ * `thread_sleep()` does, but the calling thread is woken up once @p ticks timer
+ * ticks elapse, if no other thread wakes it up before.
+ */
+int thread_sleep_timeout(unsigned ticks)
+{
+    struct thread *curr = thread_running();
+
+    if (ticks == 0) {
+        return (-ETIMEDOUT);
+    }
+
+    curr->timedout = false;
+    if (ticks != TIMEOUT_INFINITE) {
+        timeout_set(&curr->timeout, ticks);
+    }
+
+    thread_sleep();
+
+    timeout_clear(&curr->timeout);
+
+    return (curr->timedout ? -ETIMEDOUT : 0);
+}
+
+/**
+ * @details This function puts the calling thread to sleep until @p ticks timer
+ * ticks elapse. Wakeups that come earlier are ignored. If @p ticks is zero, the
+ * calling thread only yields the processor.
+ */
+void thread_sleep_ticks(unsigned ticks)
+{
+    const uint64_t deadline = timeout_deadline(ticks);
+    unsigned remaining = 0;
+
+    if (ticks == 0) {
+        thread_yield();
+        return;
+    }
+
+    while ((remaining = timeout_remaining(deadline)) > 0) {
+        thread_sleep_timeout(remaining);
+    }
+}
+
+/**
+ * @details This function wakes up the thread identified by @p tid.
+ */
+int thread_wakeup(tid_t tid)
+{
+    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid] == NULL) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid]->state == THREAD_WAITING) {
+        thread_set_state(threads[tid], THREAD_READY);
+    }
+
+    return (0);
+}
+
+/**
+ * @details This function puts all threads owned by the calling process to
+ * sleep. The calling process resumes its execution when another process invokes
+ * `process_wakeup()` which internally invokes `thread_wakeup_all()`.
+ * @note The root kernel process cannot be put to sleep.
+ */
+void thread_sleep_all(void)
+{
+    const pid_t pid = thread_running()->pid;
+
+    for (tid_t tid = 0; tid < THREADS_MAX; tid++) {
+        struct thread *t = threads[tid];
+        if ((t != NULL) && (t->pid == pid) &&
+            ((t->state == THREAD_READY) || (t->state == THREAD_RUNNING))) {
+            thread_set_state(t, THREAD_WAITING);
+        }
+    }
+
+    // Threads that are running on other cores switch out on their next tick.
+    cores_kick();
+
+    thread_yield();
+}
+
+/**
+ * @details This function wakes up all threads owned by the process identified
+ * by @p pid.
  */
-static tid_t thread_alloc(void)
+int thread_wakeup_all(pid_t pid)
 {
-    tid_t tid;
+    if (process_is_valid(pid) != 0) {
+        return (-EINVAL);
+    }
 
-    for (tid = 0; tid < THREADS_MAX; tid++) {
-        if (threads[tid].state == THREAD_AVAILABLE) {
-            threads[tid].state = THREAD_STARTED;
-            return (tid);
+    for (tid_t tid = 0; tid < THREADS_MAX; tid++) {
+        struct thread *t = threads[tid];
+        if ((t != NULL) && (t->pid == pid) && (t->state == THREAD_WAITING)) {
+            thread_set_state(t, THREAD_READY);
         }
     }
 
-    return (-EAGAIN);
+    return (0);
 }
 
 /**
- * @details Handles a timer interrupt.
+ * @details This function terminates the calling thread.
  */
-static void do_timer(void)
+noreturn void thread_exit(void *retval)
 {
-    if (running->quantum++ >= THREAD_QUANTUM) {
+    struct thread *joiner = NULL;
+    struct thread *curr = thread_running();
+
+    curr->retval = retval;
+    thread_set_state(curr, THREAD_TERMINATED);
+    thread_rt_leave(curr);
+    if (curr->detached) {
+        thread_free(curr->tid);
+    } else {
+        thread_free_memory(curr);
+        joiner = curr->joiners.head;
+        cond_broadcast(&curr->joiners);
+    }
+
+    // Hand the processor over to the first joining thread, if any.
+    if ((joiner != NULL) && (joiner->state == THREAD_READY)) {
+        thread_handoff(joiner);
+    } else {
         thread_yield();
     }
+    UNREACHABLE();
 }
 
 /**
- * @brief Releases the memory used by a thread.
- *
- * @param t Target thread.
+ * @details This function waits for the target thread to terminate.
  */
-static void thread_free_memory(struct thread *t)
+int thread_join(tid_t tid, void **retval)
 {
-    KASSERT(t != NULL);
+    return (thread_join_timeout(tid, retval, TIMEOUT_INFINITE));
+}
 
-    if (kpool_is_kpage(VADDR(t->kstack))) {
-        KASSERT(kpage_put(t->kstack) == 0);
-    } else if (t->ustack != NULL) {
-        struct process *p = process_get(t->pid);
+/**
+ * @details This function waits for the target thread to terminate, like
+ * `thread_join()` does, but it gives up once @p ticks timer ticks elapse. If
+ * @p ticks is zero, this function only polls the target thread.
+ */
+int thread_join_timeout(tid_t tid, void **retval, unsigned ticks)
+{
+    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (-EINVAL);
+    }
 
-        KASSERT(upage_free((struct pde *)vmem_pgdir_get(p->vmem),
-                           (vaddr_t)t->ustack) == 0);
+    struct thread *t = threads[tid];
+    if (t == NULL) {
+        return (-EAGAIN);
+    }
 
-        int pos = ((USER_END_VIRT - (word_t)t->ustack) / PAGE_SIZE) - 1;
-        bitmap_clear(p->ustackmap, pos);
+    if (t == thread_running() || t->pid != thread_running()->pid) {
+        return (-EINVAL);
     }
 
-    t->kstack = NULL;
-    t->ustack = NULL;
-}
+    if (t->detached) {
+        return (-EINVAL);
+    }
 
-/*============================================================================*
- * Public Functions                                                           *
- *============================================================================*/
+    const uint64_t deadline = timeout_deadline(ticks);
+    while (t->state != THREAD_TERMINATED) {
+        int ret = 0;
 
-/**
- * @details Initializes the thread system.
- */
-void thread_init(void)
-{
-    // Initializes the table of threads.
-    for (int i = 0; i < THREADS_MAX; i++) {
-        threads[i].state = THREAD_AVAILABLE;
-        threads[i].pid = -1;
+        if (ticks == TIMEOUT_INFINITE) {
+            // Hand the processor over to the target thread while waiting.
+            cond_wait_to(&t->joiners, tid);
+        } else {
+            ret = cond_wait_timeout(&t->joiners, timeout_remaining(deadline));
+        }
+
+        // Another thread joined the target thread meanwhile.
+        if (threads[tid] != t) {
+            return (-EINVAL);
+        }
+
+        // Timed out.
+        if ((ret < 0) && (t->state != THREAD_TERMINATED)) {
+            return (ret);
+        }
     }
 
-    threads[KERNEL_THREAD].state = THREAD_RUNNING;
-    threads[KERNEL_THREAD].quantum = 0;
-    threads[KERNEL_THREAD].pid = KERNEL_PROCESS;
-    threads[KERNEL_THREAD].age = 1;
-    threads[KERNEL_THREAD].kstack = NULL;
-    threads[KERNEL_THREAD].ustack = NULL;
+    if (retval != NULL) {
+        *retval = t->retval;
+        // Only the first thread to join can get the return value.
+        t->retval = NULL;
+    }
 
-    interrupt_register(INTERRUPT_TIMER, do_timer);
+    thread_free(tid);
+
+    return (0);
 }
 
 /**
- * @details Creates a new thread.
+ * @details This function detaches the target thread.
  */
-tid_t thread_create(struct process *p, void *(*start)(), void *args,
-                    void (*caller)(void))
+int thread_detach(tid_t tid)
 {
-    tid_t tid;
-    struct thread *t;
-
-    if ((p == NULL) || (process_is_valid(p->pid) != 0) || (start == NULL) ||
-        (tid = thread_alloc()) < 0) {
-        goto error0;
+    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+        return (-EINVAL);
     }
 
-    // Initializes basic TBC info.
-    t = &threads[tid];
-    t->tid = tid;
-    t->pid = p->pid;
-    t->age = 1;
-    t->state = THREAD_READY;
-    t->quantum = 0;
-    t->start = start;
-    t->args = args;
-    t->retval = NULL;
-    t->waitmap = 0;
+    struct thread *t = threads[tid];
+    if (t == NULL) {
+        return (-EAGAIN);
+    }
 
-    // Allocates thread's kernel stack.
-    void *kstack = kpage_get(true);
-    if (kstack == NULL) {
-        goto error1;
+    if (t->pid != thread_running()->pid) {
+        return (-EINVAL);
     }
-    t->kstack = kstack;
 
-    // Checks if the owner process has memory avaible for a new thread.
-    bitmap_t fbit = bitmap_first_free(&p->ustackmap, 0, sizeof(bitmap_t));
-    if (fbit >= THREADS_MAX) {
-        goto error2;
+    t->detached = true;
+    if (t->state == THREAD_TERMINATED) {
+        thread_free(tid);
     }
 
-    // Calculates the user stack base address.
-    bitmap_set(&p->ustackmap, fbit);
-    vaddr_t ubp = (vaddr_t)(USER_END_VIRT - ((fbit + 1) * PAGE_SIZE));
-    t->ustack = (byte_t *)ubp;
+    return (0);
+}
 
-    void *ksp = NULL;
-    if ((word_t)t->start == USER_BASE_VIRT) {
-        // Forges root thread.
-        ksp = interrupt_forge_stack((t->ustack + PAGE_SIZE),
-                                    t->kstack,
-                                    (void (*)(void))t->start,
-                                    __do_process_setup);
-    } else {
-        // Sets up user-created stack.
-        if (upage_alloc(
-                (struct pde *)vmem_pgdir_get(p->vmem), ubp, true, false) < 0) {
-            goto error3;
-        }
+/**
+ * @details Sets the static priority of the thread identified by @p tid to
+ * @p prio. The effective priority of the target thread is updated as well,
+ * unless it currently inherits a higher priority.
+ */
+int thread_setprio(tid_t tid, int prio)
+{
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
+    }
 
-        void *usp = uthread_forge_stack(t->ustack, t->args, start);
-        KASSERT(usp != NULL);
-        ksp = interrupt_forge_stack(usp, t->kstack, caller, __start_uthread);
+    if ((prio < THREAD_PRIO_MIN) || (prio > THREAD_PRIO_MAX)) {
+        return (-EINVAL);
     }
-    KASSERT(ksp != NULL);
 
-    // Creates initial thread context.
-    KASSERT(context_create(&t->ctx,
-                           vmem_pgdir_get(p->vmem),
-                           (const void *)(t->kstack + PAGE_SIZE),
-                           ksp) == 0);
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
+    }
 
-    return tid;
+    struct thread *t = threads[tid];
 
-error3:
-    bitmap_clear(p->ustackmap, fbit);
-error2:
-    kpage_put(kstack);
-error1:
-    t->pid = -1;
-    t->state = THREAD_AVAILABLE;
-    t->start = NULL;
-    t->args = NULL;
-error0:
-    return (-1);
+    // Do not drop an inherited priority.
+    const bool inherited = (t->prio > t->baseprio);
+    t->baseprio = prio;
+    if (!inherited || (prio > t->prio)) {
+        thread_set_prio(t, prio);
+    }
+
+    return (0);
 }
 
 /**
- * @details Releases a thread entry.
+ * @details Gets the static priority of the thread identified by @p tid.
  */
-int thread_free(tid_t tid)
+int thread_getprio(tid_t tid)
 {
-    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+    if (!thread_is_valid(tid)) {
         return (-EINVAL);
     }
-    struct thread *t = &threads[tid];
-
-    thread_free_memory(t);
 
-    t->pid = -1;
-    t->tid = -1;
-    t->start = NULL;
-    t->args = NULL;
-    t->retval = NULL;
-    t->age = -1;
-    t->quantum = -1;
-    t->state = THREAD_AVAILABLE;
-    t->waitmap = 0;
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
+    }
 
-    return (0);
+    return (threads[tid]->baseprio);
 }
 
 /**
- * @details Releases all threads owned by the target process.
+ * @details Raises the effective priority of the thread identified by @p tid to
+ * @p prio, if it is lower than that. This is a no-op if @p tid does not refer
+ * to a thread that is in use.
  */
-int thread_free_all(pid_t pid)
+void thread_prio_inherit(tid_t tid, int prio)
 {
-    if (pid == KERNEL_PROCESS || process_is_valid(pid) != 0) {
-        return (-EINVAL);
+    if (!thread_is_valid(tid)) {
+        return;
     }
 
-    for (int i = 0; i < THREADS_MAX; i++) {
-        if (threads[i].pid == pid) {
-            thread_free(threads[i].tid);
-        }
+    if (threads[tid]->prio < prio) {
+        thread_set_prio(threads[tid], prio);
     }
-
-    return (0);
 }
 
 /**
- * @details Gets the context of the target thread.
+ * @details Drops any priority inherited by the thread identified by @p tid,
+ * except for @p prio, so that its effective priority matches the highest of its
+ * static priority and @p prio. This is a no-op if @p tid does not refer to a
+ * thread that is in use.
  */
-struct context *thread_get_ctx(tid_t tid)
+void thread_prio_restore(tid_t tid, int prio)
 {
-    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
-        return (NULL);
+    if (!thread_is_valid(tid)) {
+        return;
     }
 
-    return (&threads[tid].ctx);
+    struct thread *t = threads[tid];
+    thread_set_prio(t, (prio > t->baseprio) ? prio : t->baseprio);
 }
 
 /**
- * @details Gets the running thread.
+ * @details Gets the effective priority of the calling thread.
  */
-tid_t thread_get_curr(void)
+int thread_prio_curr(void)
 {
-    return (running->tid);
+    return (thread_running()->prio);
 }
 
 /**
- * @details Gets the Process ID of the target thread.
+ * @details Sets the quantum of the thread identified by @p tid to @p quantum
+ * timer ticks. If @p quantum is THREAD_QUANTUM_ADAPTIVE, the target thread
+ * switches to the adaptive policy instead, starting from the default quantum.
+ * The new quantum takes effect from the next time slice of the target thread.
  */
-pid_t thread_get_pid(tid_t tid)
+int thread_setquantum(tid_t tid, unsigned quantum)
 {
-    if (tid < KERNEL_THREAD || tid >= THREADS_MAX) {
+    if (!thread_is_valid(tid)) {
         return (-EINVAL);
     }
 
-    return (threads[tid].pid);
+    if ((quantum != THREAD_QUANTUM_ADAPTIVE) &&
+        ((quantum < THREAD_QUANTUM_MIN) || (quantum > THREAD_QUANTUM_MAX))) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
+    }
+
+    if (quantum == THREAD_QUANTUM_ADAPTIVE) {
+        threads[tid]->adaptive = true;
+        threads[tid]->slice = THREAD_QUANTUM_DEFAULT;
+    } else {
+        threads[tid]->adaptive = false;
+        threads[tid]->slice = quantum;
+    }
+
+    return (0);
 }
 
 /**
- * @details Yields the CPU.
+ * @details Gets quantum information of the thread identified by @p tid and
+ * stores it in the location pointed to by @p buf.
  */
-void thread_yield(void)
+int thread_getquantum(tid_t tid, struct thread_quantum *buf)
 {
-    struct thread *prev = running;
-    struct thread *next = &threads[KERNEL_THREAD];
+    if (buf == NULL) {
+        return (-EINVAL);
+    }
 
-    if (running->state == THREAD_RUNNING) {
-        running->state = THREAD_READY;
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
     }
 
-    /* Selects the next thread to run. */
-    for (int i = 0; i < THREADS_MAX; i++) {
-        if (threads[i].state == THREAD_READY) {
-            if (threads[i].age++ >= next->age) {
-                next = &threads[i];
-            }
-        }
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
     }
 
-    running = next;
-    running->age = 0;
-    running->quantum = 0;
-    running->state = THREAD_RUNNING;
+    buf->quantum = threads[tid]->slice;
+    buf->adaptive = threads[tid]->adaptive;
+    buf->slices_used = threads[tid]->slices;
+    buf->slices_expired = threads[tid]->expired;
 
-    __context_switch(&prev->ctx, &next->ctx);
+    return (0);
 }
 
 /**
- * @details This function puts the calling thread to sleep. The calling thread
- * resumes its execution when another thread invokes `thread_wakeup()`.
- * @note The root kernel thread cannot be put to sleep.
+ * @details Gets statistics of the thread identified by @p tid and stores them
+ * in the location pointed to by @p buf. Statistics of threads from any process
+ * may be queried.
  */
-void thread_sleep(void)
+int thread_getstats(tid_t tid, struct thread_stats *buf)
 {
-    running->state = THREAD_WAITING;
-    thread_yield();
+    if (buf == NULL) {
+        return (-EINVAL);
+    }
+
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
+    }
+
+    struct thread *t = threads[tid];
+
+    // Bring statistics of the calling thread up to date.
+    if (t == thread_running()) {
+        thread_account(t, cpu_cycles());
+    }
+
+    __memcpy(buf, &t->stats, sizeof(struct thread_stats));
+
+    return (0);
 }
 
 /**
- * @details This function wakes up the thread identified by @p tid.
+ * @details Adds up statistics of all threads of the process identified by
+ * @p pid, including those that were released, and stores them in the location
+ * pointed to by @p buf. Statistics of any process may be queried. Idle time is
+ * accounted to the kernel process.
  */
-int thread_wakeup(tid_t tid)
+int thread_getstats_all(pid_t pid, struct thread_stats *buf)
 {
-    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+    if (buf == NULL) {
         return (-EINVAL);
     }
 
-    threads[tid].state = THREAD_READY;
+    if (process_is_valid(pid) != 0) {
+        return (-EINVAL);
+    }
+
+    // Bring statistics of the calling thread up to date.
+    thread_account(thread_running(), cpu_cycles());
+
+    __memcpy(buf, &released_stats[pid], sizeof(struct thread_stats));
+    for (tid_t tid = 0; tid < THREADS_MAX; tid++) {
+        if ((threads[tid] != NULL) && (threads[tid]->pid == pid)) {
+            thread_stats_add(buf, &threads[tid]->stats);
+        }
+    }
 
     return (0);
 }
 
 /**
- * @details This function puts all threads owned by the calling process to
- * sleep. The calling process resumes its execution when another process invokes
- * `process_wakeup()` which internally invokes `thread_wakeup_all()`.
- * @note The root kernel process cannot be put to sleep.
+ * @details Charges the time since the last accounting event of the calling
+ * thread to user mode, and starts charging kernel time. Kernel calls may be
+ * nested.
  */
-void thread_sleep_all(void)
+void thread_kcall_enter(void)
 {
-    for (int i = 0; i < THREADS_MAX; i++) {
-        if (threads[i].pid == running->pid) {
-            threads[i].state = THREAD_WAITING;
-        }
-    }
+    struct thread *curr = thread_running();
 
-    thread_yield();
+    thread_account(curr, cpu_cycles());
+    curr->kdepth++;
 }
 
 /**
- * @details This function wakes up all threads owned by the process identified
- * by @p pid.
+ * @details Charges the time since the last accounting event of the calling
+ * thread to the kernel call it is leaving.
  */
-int thread_wakeup_all(pid_t pid)
+void thread_kcall_leave(void)
 {
-    if (pid == KERNEL_PROCESS || process_is_valid(pid) != 0) {
+    struct thread *curr = thread_running();
+
+    thread_account(curr, cpu_cycles());
+    curr->kdepth--;
+}
+
+/**
+ * @details Sets the real-time parameters of the thread identified by @p tid.
+ * The budget of the target thread should not exceed its relative deadline,
+ * which in turn should not exceed its period. If the target thread is not
+ * admitted, its real-time parameters are left unchanged.
+ */
+int thread_setrt(tid_t tid, const struct thread_rt *params)
+{
+    if (params == NULL) {
         return (-EINVAL);
     }
 
-    for (int i = 0; i < THREADS_MAX; i++) {
-        if (threads[i].pid == pid) {
-            threads[i].state = THREAD_READY;
-        }
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
+    }
+
+    struct thread *t = threads[tid];
+
+    // Leave the real-time class.
+    if (params->period == 0) {
+        thread_rt_leave(t);
+        return (0);
+    }
+
+    if ((params->budget == 0) || (params->budget > params->deadline) ||
+        (params->deadline > params->period) ||
+        (params->period > THREAD_RT_PERIOD_MAX)) {
+        return (-EINVAL);
+    }
+
+    // Admission control.
+    const unsigned current = thread_is_rt(t) ? thread_rt_density(&t->rt) : 0;
+    if ((rt_density - current + thread_rt_density(params)) >
+        THREAD_RT_DENSITY_MAX) {
+        return (-EBUSY);
     }
 
+    thread_rt_leave(t);
+    thread_rt_enter(t, params);
+
     return (0);
 }
 
 /**
- * @details This function terminates the calling thread.
+ * @details Gets the real-time parameters of the thread identified by @p tid.
+ * A thread in the regular scheduling class has all parameters set to zero.
  */
-noreturn void thread_exit(void *retval)
+int thread_getrt(tid_t tid, struct thread_rt *buf)
 {
-    running->retval = retval;
-    running->state = THREAD_TERMINATED;
-    if (running->detached) {
-        thread_free(running->tid);
-    } else {
-        thread_free_memory(running);
-        for (int i = 0; i < THREADS_MAX; i++) {
-            if (bitmap_check_bit(&running->waitmap, threads[i].tid)) {
-                threads[i].state = THREAD_READY;
-                bitmap_clear(&running->waitmap, threads[i].tid);
-            }
-        }
+    if (buf == NULL) {
+        return (-EINVAL);
     }
-    thread_yield();
-    UNREACHABLE();
+
+    if (!thread_is_valid(tid)) {
+        return (-EINVAL);
+    }
+
+    if (threads[tid]->pid != thread_running()->pid) {
+        return (-EPERM);
+    }
+
+    __memcpy(buf, &threads[tid]->rt, sizeof(struct thread_rt));
+
+    return (0);
 }
 
 /**
- * @details This function waits for the target thread to terminate.
+ * @details Sets the fair share parameters of the process identified by
+ * @p pid. The quota of a process should not exceed its period on all cores
+ * that are online. Changing the quota of a process starts a new period, thus
+ * a throttled process may run again right away. The kernel process may not be
+ * capped.
  */
-int thread_join(tid_t tid, void **retval)
+int thread_setshare(pid_t pid, const struct thread_share *params)
 {
-    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+    if (params == NULL) {
         return (-EINVAL);
     }
 
-    if (threads[tid].state == THREAD_AVAILABLE) {
-        return (-EAGAIN);
+    if ((pid == KERNEL_PROCESS) || (process_is_valid(pid) != 0)) {
+        return (-EINVAL);
     }
 
-    if (tid == running->tid || threads[tid].pid != running->pid) {
+    if ((params->weight < THREAD_SHARE_WEIGHT_MIN) ||
+        (params->weight > THREAD_SHARE_WEIGHT_MAX)) {
         return (-EINVAL);
     }
 
-    if (threads[tid].detached) {
+    if ((params->quota != 0) &&
+        ((params->period == 0) || (params->period > THREAD_SHARE_PERIOD_MAX) ||
+         (params->quota > (params->period * cores_online())))) {
         return (-EINVAL);
     }
 
-    if (threads[tid].state != THREAD_TERMINATED) {
-        running->state = THREAD_WAITING;
-        bitmap_set(&threads[tid].waitmap, running->tid);
-        thread_yield();
-    }
+    struct share *s = &shares[pid];
 
-    if (retval != NULL) {
-        *retval = threads[tid].retval;
-        // Only the first thread to join can get the return value.
-        threads[tid].retval = NULL;
-    }
+    s->params.weight = params->weight;
+    s->rate =
+        (THREAD_SHARE_WEIGHT_DEFAULT << SHARE_RATE_SHIFT) / params->weight;
 
-    thread_free(tid);
+    if ((params->quota != s->params.quota) ||
+        (params->period != s->params.period)) {
+        timeout_clear(&s->timer);
+        s->params.quota = params->quota;
+        s->params.period = (params->quota != 0) ? params->period : 0;
+        s->release = interrupts_get_ticks();
+        s->used = 0;
+        s->throttled = false;
+    }
 
     return (0);
 }
 
 /**
- * @details This function detaches the target thread.
+ * @details Gets the fair share parameters of the process identified by
+ * @p pid. Parameters of any process may be queried.
  */
-int thread_detach(tid_t tid)
+int thread_getshare(pid_t pid, struct thread_share *buf)
 {
-    if (tid <= KERNEL_THREAD || tid >= THREADS_MAX) {
+    if (buf == NULL) {
         return (-EINVAL);
     }
 
-    if (threads[tid].state == THREAD_AVAILABLE) {
-        return (-EAGAIN);
+    if (process_is_valid(pid) != 0) {
+        return (-EINVAL);
     }
 
-    if (threads[tid].pid != running->pid) {
+    __memcpy(buf, &shares[pid].params, sizeof(struct thread_share));
+
+    return (0);
+}
+
+/**
+ * @details Sets the TLS base address of the calling thread to @p base. The TLS
+ * segment is switched right away, and it is switched again whenever the
+ * calling thread is scheduled.
+ */
+int thread_set_tls(word_t base)
+{
+    struct thread *curr = thread_running();
+
+    curr->tls = base;
+    gdt_tls_switch(base);
+
+    return (0);
+}
+
+/**
+ * @details Sets the bound of address space affinity to @p bound. The previous
+ * bound is returned, so that it can be restored later.
+ */
+int thread_set_affinity(unsigned bound)
+{
+    if (bound > THREAD_AFFINITY_MAX) {
         return (-EINVAL);
     }
 
-    threads[tid].detached = true;
-    if (threads[tid].state == THREAD_TERMINATED) {
-        thread_free(tid);
-    }
+    const unsigned old = affinity_bound;
+    affinity_bound = bound;
 
-    return (0);
+    return ((int)old);
 }
@@ -0,0 +1,292 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+/*============================================================================*
+ * Imports                                                                    *
+ *============================================================================*/
+
+#include <nanvix/kernel/hal.h>
+#include <nanvix/kernel/lib.h>
+#include <nanvix/kernel/pm/timeout.h>
+#include <stdint.h>
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Number of levels in the timer wheel.
+ */
+#define WHEEL_LEVELS 4
+
+/**
+ * @brief Number of slots in each level of the timer wheel (log 2).
+ */
+#define WHEEL_SHIFT 6
+
+/**
+ * @brief Number of slots in each level of the timer wheel.
+ */
+#define WHEEL_SLOTS (1 << WHEEL_SHIFT)
+
+/**
+ * @brief Longest timeout that the timer wheel holds (in ticks).
+ *
+ * @details Longer timeouts are held at the last level, and they are cascaded
+ * again until they expire.
+ */
+#define WHEEL_SPAN ((uint64_t)1 << (WHEEL_SHIFT * WHEEL_LEVELS))
+
+/*============================================================================*
+ * Private Variables                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Timer wheel.
+ *
+ * @details Each slot of level `i` spans `WHEEL_SLOTS^i` timer ticks. Timeouts
+ * are cascaded to a lower level when the wheel wraps around that level.
+ */
+static struct {
+    uint64_t now;                                     /** Last tick run. */
+    unsigned pending;                                 /** Pending.       */
+    struct timeout *slots[WHEEL_LEVELS][WHEEL_SLOTS]; /** Slots.         */
+} wheel;
+
+/*============================================================================*
+ * Private Functions                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Gets the slot of a level of the timer wheel that a time falls in.
+ *
+ * @param level Target level.
+ * @param time  Target time (in ticks).
+ *
+ * @returns A pointer to the target slot.
+ */
+static inline struct timeout **wheel_slot(unsigned level, uint64_t time)
+{
+    return (&wheel.slots[level]
+                        [(time >> (level * WHEEL_SHIFT)) & (WHEEL_SLOTS - 1)]);
+}
+
+/**
+ * @brief Inserts a timeout in the timer wheel.
+ *
+ * @details The level of the timeout is chosen from how far in the future the
+ * timeout expires, counting from the first tick that the timer wheel has not
+ * run yet.
+ *
+ * @param to   Target timeout.
+ * @param next First tick that the timer wheel has not run yet.
+ */
+static void wheel_insert(struct timeout *to, uint64_t next)
+{
+    uint64_t expires = to->expires;
+    unsigned level = 0;
+
+    // Expire late timeouts on the next tick.
+    if (expires < next) {
+        expires = next;
+    }
+
+    // Hold far timeouts at the last level.
+    if ((expires - next) >= WHEEL_SPAN) {
+        expires = next + WHEEL_SPAN - 1;
+    }
+
+    while ((level < (WHEEL_LEVELS - 1)) &&
+           ((expires - next) >= ((uint64_t)1 << ((level + 1) * WHEEL_SHIFT)))) {
+        level++;
+    }
+
+    struct timeout **head = wheel_slot(level, expires);
+    to->head = head;
+    to->prev = NULL;
+    to->next = *head;
+    if (*head != NULL) {
+        (*head)->prev = to;
+    }
+    *head = to;
+}
+
+/**
+ * @brief Removes a timeout from the timer wheel.
+ *
+ * @param to Target timeout.
+ */
+static void wheel_remove(struct timeout *to)
+{
+    if (to->prev != NULL) {
+        to->prev->next = to->next;
+    } else {
+        *to->head = to->next;
+    }
+    if (to->next != NULL) {
+        to->next->prev = to->prev;
+    }
+
+    to->head = NULL;
+    to->prev = NULL;
+    to->next = NULL;
+}
+
+/**
+ * @brief Moves all timeouts of a slot to lower levels of the timer wheel.
+ *
+ * @param head Target slot.
+ * @param now  Tick that the timer wheel is running.
+ */
+static void wheel_cascade(struct timeout **head, uint64_t now)
+{
+    struct timeout *to = *head;
+
+    *head = NULL;
+    while (to != NULL) {
+        struct timeout *next = to->next;
+        wheel_insert(to, now);
+        to = next;
+    }
+}
+
+/**
+ * @brief Runs the next tick of the timer wheel.
+ *
+ * @details Slots of upper levels are cascaded when lower levels wrap around,
+ * then all timeouts of the current slot of the first level expire. Cascaded
+ * timeouts are placed relative to the tick that is running, so that those that
+ * expire on this tick land in the slot that expires next.
+ */
+static void wheel_tick(void)
+{
+    const uint64_t now = wheel.now + 1;
+    unsigned level = 1;
+
+    // Find out the highest level that wraps around.
+    while ((level < WHEEL_LEVELS) &&
+           ((now & (((uint64_t)1 << (level * WHEEL_SHIFT)) - 1)) == 0)) {
+        level++;
+    }
+
+    wheel.now = now;
+
+    // Cascade from the highest level down.
+    while (--level > 0) {
+        wheel_cascade(wheel_slot(level, now), now);
+    }
+
+    struct timeout **head = wheel_slot(0, now);
+    while (*head != NULL) {
+        struct timeout *to = *head;
+        wheel_remove(to);
+        wheel.pending--;
+        to->fn(to->arg);
+    }
+}
+
+/*============================================================================*
+ * Public Functions                                                           *
+ *============================================================================*/
+
+/**
+ * @details Sets the timeout pointed to by @p to to expire @p ticks timer ticks
+ * from now. A timeout that is set to expire zero ticks from now expires on the
+ * next timer tick.
+ */
+void timeout_set(struct timeout *to, unsigned ticks)
+{
+    KASSERT(to != NULL);
+    KASSERT(to->fn != NULL);
+
+    timeout_clear(to);
+
+    const uint64_t now = interrupts_get_ticks();
+
+    // Catch up with skipped ticks, if no timeout is pending.
+    if ((wheel.pending == 0) && (wheel.now < now)) {
+        wheel.now = now;
+    }
+
+    to->expires = now + ticks;
+    wheel_insert(to, wheel.now + 1);
+    wheel.pending++;
+}
+
+/**
+ * @details Clears the timeout pointed to by @p to, so that it does not expire.
+ */
+void timeout_clear(struct timeout *to)
+{
+    KASSERT(to != NULL);
+
+    if (timeout_pending(to)) {
+        wheel_remove(to);
+        wheel.pending--;
+    }
+}
+
+/**
+ * @details Runs the timer wheel up to time @p now, expiring timeouts on the
+ * way. Ticks that were skipped while idling are run at once. If no timeout is
+ * pending, the timer wheel jumps straight to @p now.
+ */
+void timeout_expire(uint64_t now)
+{
+    while (wheel.now < now) {
+        if (wheel.pending == 0) {
+            wheel.now = now;
+            break;
+        }
+        wheel_tick();
+    }
+}
+
+/**
+ * @details Gets the number of timer ticks until the next timeout expires. Only
+ * the first level of the timer wheel is looked up, thus if no timeout expires
+ * before it wraps around, the number of ticks until it wraps around is
+ * returned instead.
+ */
+unsigned timeout_next(void)
+{
+    if (wheel.pending == 0) {
+        return (TIMEOUT_INFINITE);
+    }
+
+    const uint64_t now = interrupts_get_ticks();
+    if (now > wheel.now) {
+        return (1);
+    }
+
+    unsigned ticks = 1;
+    for (; ticks < WHEEL_SLOTS; ticks++) {
+        const uint64_t time = wheel.now + ticks;
+        if (*wheel_slot(0, time) != NULL) {
+            break;
+        }
+        // Stop once the first level wraps around.
+        if ((time & (WHEEL_SLOTS - 1)) == 0) {
+            break;
+        }
+    }
+
+    return (ticks);
+}
+
+/**
+ * @details Initializes the timer wheel. The timer wheel starts at the current
+ * time.
+ */
+void timeout_wheel_init(void)
+{
+    wheel.now = interrupts_get_ticks();
+    wheel.pending = 0;
+    for (unsigned level = 0; level < WHEEL_LEVELS; level++) {
+        for (unsigned slot = 0; slot < WHEEL_SLOTS; slot++) {
+            wheel.slots[level][slot] = NULL;
+        }
+    }
+}
@@ -129,6 +129,11 @@
 #define UART_LSR_ERR (1 << 7) /** Erroneous Data in FIFO      */
 /**@}*/
 
+/**
+ * @brief Size of the transmitter FIFO (in bytes).
+ */
+#define UART_TX_FIFO_SIZE 16
+
 /**
  * @brief Bits in the Modem Status Register (MSR)
  */
@@ -221,6 +226,26 @@ static void uart_disable_interrupts(void)
     output8(uart_base_addr + UART_IER, 0x00);
 }
 
+/**
+ * @brief Writes to the interrupt enable register.
+ *
+ * @param value Value to be written.
+ */
+static void uart_write_ier(uint8_t value)
+{
+    output8(uart_base_addr + UART_IER, value);
+}
+
+/**
+ * @brief Reads the line status register.
+ *
+ * @returns The contents of the line status register.
+ */
+static uint8_t uart_read_lsr(void)
+{
+    return (input8(uart_base_addr + UART_LSR));
+}
+
 /**
  * @brief Sets baud rate.
  *
@@ -318,6 +343,26 @@ static void uart_disable_interrupts(void)
     uart_base_addr[UART_IER] = 0x00;
 }
 
+/**
+ * @brief Writes to the interrupt enable register.
+ *
+ * @param value Value to be written.
+ */
+static void uart_write_ier(uint8_t value)
+{
+    uart_base_addr[UART_IER] = value;
+}
+
+/**
+ * @brief Reads the line status register.
+ *
+ * @returns The contents of the line status register.
+ */
+static uint8_t uart_read_lsr(void)
+{
+    return (uart_base_addr[UART_LSR]);
+}
+
 /**
  * @brief Sets baud rate.
  *
@@ -376,6 +421,47 @@ void uart_write(const char *buf, size_t len)
     }
 }
 
+/**
+ * @details Writes at most @p len bytes from the buffer pointed to by @p buf on
+ * the UART device, without waiting for the transmitter. Bytes are written only
+ * if the transmitter FIFO is empty, and at most as many bytes as fit in it.
+ */
+size_t uart_write_nonblock(const char *buf, size_t len)
+{
+    size_t n = 0;
+
+    /* Device is not initialized, do nothing. */
+    if (!initialized) {
+        return (0);
+    }
+
+    /* Transmitter is busy. */
+    if ((uart_read_lsr() & UART_LSR_TFE) == 0) {
+        return (0);
+    }
+
+    /* Fill transmitter FIFO. */
+    while ((n < len) && (n < UART_TX_FIFO_SIZE)) {
+        uart_write_data(buf[n++]);
+    }
+
+    return (n);
+}
+
+/**
+ * @details Enables or disables the transmitter holding register empty
+ * interrupt of the UART device, according to @p enable.
+ */
+void uart_tx_interrupt(bool enable)
+{
+    /* Device is not initialized, do nothing. */
+    if (!initialized) {
+        return;
+    }
+
+    uart_write_ier(enable ? UART_IER_THRI : 0x00);
+}
+
 /**
  * @details Initializes the UART device.
  */
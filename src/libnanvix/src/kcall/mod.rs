@@ -7,19 +7,54 @@
 // Modules
 //==============================================================================
 
+mod ring;
+mod stats;
 mod void;
 
 //==============================================================================
 // Exports
 //==============================================================================
 
-pub use self::void::*;
+pub use self::{
+    ring::*,
+    stats::*,
+    void::*,
+};
 
 //==============================================================================
 // Imports
 //==============================================================================
 
-use core::arch;
+use core::{
+    arch,
+    sync::atomic::{
+        AtomicU8,
+        Ordering,
+    },
+};
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Support for fast kernel calls was not probed yet.
+const FAST_KCALL_UNKNOWN: u8 = 0;
+
+/// Fast kernel calls are not supported.
+const FAST_KCALL_UNSUPPORTED: u8 = 1;
+
+/// Fast kernel calls are supported.
+const FAST_KCALL_SUPPORTED: u8 = 2;
+
+/// CPUID feature flag for SYSENTER/SYSEXIT instructions (EDX of leaf 1).
+const CPUID_FEATURES_EDX_SEP: u32 = 1 << 11;
+
+//==============================================================================
+// Global Variables
+//==============================================================================
+
+/// Cached support for fast kernel calls.
+static FAST_KCALL: AtomicU8 = AtomicU8::new(FAST_KCALL_UNKNOWN);
 
 //==============================================================================
 // Enumerations
@@ -32,6 +67,7 @@ pub enum KcallNumbers {
     Void2 = 2,
     Void3 = 3,
     Void4 = 4,
+    Void5 = 5,
     Shutdown = 6,
     Write = 7,
     FrameAlloc = 8,
@@ -54,12 +90,116 @@ pub enum KcallNumbers {
     Boxtag = 25,
     ThreadJoin = 26,
     ThreadDetach = 27,
+    KcallSubmit = 28,
+    Stats = 29,
+    ThreadSetprio = 30,
+    ThreadGetprio = 31,
+    ThreadSetquantum = 32,
+    ThreadGetquantum = 33,
+    ThreadYieldTo = 34,
+    ThreadStats = 35,
+    ProcessStats = 36,
+    Sleep = 37,
+    ThreadJoinTimeout = 38,
+    ThreadSetrt = 39,
+    ThreadGetrt = 40,
+    SchedAffinity = 41,
+    ThreadSettls = 42,
+    ProcessSetshare = 43,
+    ProcessGetshare = 44,
+    ProcessGet = 45,
+    /// One past the highest kernel call number (see `NR_last_kcall`).
+    LastKcall,
 }
 
 //==============================================================================
 // Private Standalone Functions
 //==============================================================================
 
+///
+/// **Description**
+///
+/// Checks whether fast kernel calls (SYSENTER/SYSEXIT) are supported. The
+/// processor is probed only once, and the result is cached afterwards.
+///
+/// **Return**
+///
+/// If fast kernel calls are supported, `true` is returned. Otherwise, `false`
+/// is returned instead.
+///
+#[inline]
+fn fast_kcall_supported() -> bool {
+    match FAST_KCALL.load(Ordering::Relaxed) {
+        FAST_KCALL_SUPPORTED => true,
+        FAST_KCALL_UNSUPPORTED => false,
+        _ => {
+            let features: arch::x86::CpuidResult =
+                unsafe { arch::x86::__cpuid(1) };
+            let supported: bool = (features.edx & CPUID_FEATURES_EDX_SEP) != 0;
+            FAST_KCALL.store(
+                if supported {
+                    FAST_KCALL_SUPPORTED
+                } else {
+                    FAST_KCALL_UNSUPPORTED
+                },
+                Ordering::Relaxed,
+            );
+            supported
+        },
+    }
+}
+
+///
+/// **Description**
+///
+/// Issues a kernel call through the fast entry point (SYSENTER/SYSEXIT).
+///
+/// **Parameters**
+/// - `kcall_nr` - Kernel call number.
+/// - `arg0` - First argument for the kernel call.
+/// - `arg1` - Second argument for the kernel call.
+/// - `arg2` - Third argument for the kernel call.
+/// - `arg3` - Fourth argument for the kernel call.
+///
+/// **Return**
+///
+/// This function returns the value returned by the kernel call.
+///
+/// **Notes**
+///
+/// The kernel expects the second and third arguments in `esi` and `ebp`, and
+/// the user stack pointer and return address in `ecx` and `edx`. Neither `esi`
+/// nor `ebp` may be used as operands, thus they are saved and loaded here.
+///
+#[inline(always)]
+unsafe fn kcall_fast(
+    kcall_nr: u32,
+    arg0: u32,
+    arg1: u32,
+    arg2: u32,
+    arg3: u32,
+) -> u32 {
+    let ret: u32;
+    arch::asm!(
+        "push ebp",
+        "push esi",
+        "mov esi, ecx",
+        "mov ebp, edx",
+        "mov ecx, esp",
+        "lea edx, [2f]",
+        "sysenter",
+        "2:",
+        "pop esi",
+        "pop ebp",
+        inout("eax") kcall_nr => ret,
+        in("ebx") arg0,
+        inout("ecx") arg1 => _,
+        inout("edx") arg2 => _,
+        in("edi") arg3,
+    );
+    ret
+}
+
 ///
 /// **Description**
 ///
@@ -72,11 +212,17 @@ pub enum KcallNumbers {
 ///
 /// This function returns the value returned by the kernel call.
 ///
-#[inline(never)]
+#[inline]
 pub unsafe fn kcall0(kcall_nr: u32) -> u32 {
+    if fast_kcall_supported() {
+        return kcall_fast(kcall_nr, 0, 0, 0, 0);
+    }
+
     let ret: u32;
     arch::asm!("int 0x80",
         inout("eax") kcall_nr => ret,
+        lateout("ecx") _,
+        lateout("edx") _,
         options(nostack, preserves_flags)
     );
     ret
@@ -95,12 +241,18 @@ pub unsafe fn kcall0(kcall_nr: u32) -> u32 {
 ///
 /// This function returns the value returned by the kernel call.
 ///
-#[inline(never)]
+#[inline]
 pub unsafe fn kcall1(kcall_nr: u32, arg0: u32) -> u32 {
+    if fast_kcall_supported() {
+        return kcall_fast(kcall_nr, arg0, 0, 0, 0);
+    }
+
     let ret: u32;
     arch::asm!("int 0x80",
         inout("eax") kcall_nr => ret,
         in("ebx") arg0,
+        lateout("ecx") _,
+        lateout("edx") _,
         options(nostack, preserves_flags)
     );
     ret
@@ -120,13 +272,18 @@ pub unsafe fn kcall1(kcall_nr: u32, arg0: u32) -> u32 {
 ///
 /// This function returns the value returned by the kernel call.
 ///
-#[inline(never)]
+#[inline]
 pub unsafe fn kcall2(kcall_nr: u32, arg0: u32, arg1: u32) -> u32 {
+    if fast_kcall_supported() {
+        return kcall_fast(kcall_nr, arg0, arg1, 0, 0);
+    }
+
     let ret: u32;
     arch::asm!("int 0x80",
         inout("eax") kcall_nr => ret,
         in("ebx") arg0,
-        in("ecx") arg1,
+        inout("ecx") arg1 => _,
+        lateout("edx") _,
         options(nostack, preserves_flags)
     );
     ret
@@ -147,14 +304,18 @@ pub unsafe fn kcall2(kcall_nr: u32, arg0: u32, arg1: u32) -> u32 {
 ///
 /// This function returns the value returned by the kernel call.
 ///
-#[inline(never)]
+#[inline]
 pub unsafe fn kcall3(kcall_nr: u32, arg0: u32, arg1: u32, arg2: u32) -> u32 {
+    if fast_kcall_supported() {
+        return kcall_fast(kcall_nr, arg0, arg1, arg2, 0);
+    }
+
     let ret: u32;
     arch::asm!("int 0x80",
         inout("eax") kcall_nr => ret,
         in("ebx") arg0,
-        in("ecx") arg1,
-        in("edx") arg2,
+        inout("ecx") arg1 => _,
+        inout("edx") arg2 => _,
         options(nostack, preserves_flags)
     );
     ret
@@ -176,7 +337,7 @@ pub unsafe fn kcall3(kcall_nr: u32, arg0: u32, arg1: u32, arg2: u32) -> u32 {
 ///
 /// This function returns the value returned by the kernel call.
 ///
-#[inline(never)]
+#[inline]
 pub unsafe fn kcall4(
     kcall_nr: u32,
     arg0: u32,
@@ -184,14 +345,73 @@ pub unsafe fn kcall4(
     arg2: u32,
     arg3: u32,
 ) -> u32 {
+    if fast_kcall_supported() {
+        return kcall_fast(kcall_nr, arg0, arg1, arg2, arg3);
+    }
+
     let ret: u32;
     arch::asm!("int 0x80",
         inout("eax") kcall_nr => ret,
         in("ebx") arg0,
-        in("ecx") arg1,
-        in("edx") arg2,
+        inout("ecx") arg1 => _,
+        inout("edx") arg2 => _,
         in("edi") arg3,
         options(nostack, preserves_flags)
     );
     ret
 }
+
+///
+/// **Description**
+///
+/// Issues a kernel call with five arguments.
+///
+/// **Parameters**
+/// - `kcall_nr` - Kernel call number.
+/// - `arg0` - First argument for the kernel call.
+/// - `arg1` - Second argument for the kernel call.
+/// - `arg2` - Third argument for the kernel call.
+/// - `arg3` - Fourth argument for the kernel call.
+/// - `arg4` - Fifth argument for the kernel call.
+///
+/// **Return**
+///
+/// This function returns the value returned by the kernel call.
+///
+/// **Notes**
+///
+/// The fifth argument goes in `esi`, which may not be used as an operand.
+/// Therefore, all arguments are loaded from memory inside the assembly block.
+/// The fast entry point has no room for a fifth argument, thus this function
+/// always traps through `int 0x80`.
+///
+#[inline]
+pub unsafe fn kcall5(
+    kcall_nr: u32,
+    arg0: u32,
+    arg1: u32,
+    arg2: u32,
+    arg3: u32,
+    arg4: u32,
+) -> u32 {
+    let ret: u32;
+    let args: [u32; 6] = [kcall_nr, arg0, arg1, arg2, arg3, arg4];
+    arch::asm!(
+        "push esi",
+        "mov ebx, [eax + 4]",
+        "mov ecx, [eax + 8]",
+        "mov edx, [eax + 12]",
+        "mov edi, [eax + 16]",
+        "mov esi, [eax + 20]",
+        "mov eax, [eax]",
+        "int 0x80",
+        "pop esi",
+        inout("eax") args.as_ptr() => ret,
+        out("ebx") _,
+        out("ecx") _,
+        out("edx") _,
+        out("edi") _,
+        options(preserves_flags)
+    );
+    ret
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+use super::{
+    kcall2,
+    KcallNumbers,
+};
+use core::ptr;
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Number of entries in a kernel call ring.
+pub const KCALL_RING_LENGTH: usize = 64;
+
+//==============================================================================
+// Structures
+//==============================================================================
+
+/// Kernel call submission entry.
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct SubmissionEntry {
+    /// Kernel call number.
+    pub kcall_nr: u32,
+    /// Kernel call arguments.
+    pub args: [u32; 5],
+    /// Tag echoed in the completion entry.
+    pub tag: u32,
+}
+
+/// Kernel call completion entry.
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct CompletionEntry {
+    /// Tag of the submission entry.
+    pub tag: u32,
+    /// Return value of the kernel call.
+    pub ret: i32,
+}
+
+///
+/// **Description**
+///
+/// Kernel call ring. This structure is shared with the kernel: user code
+/// queues submission entries and the kernel posts completion entries. Its
+/// layout must match `struct kcall_ring` in the kernel.
+///
+#[repr(C, align(4096))]
+pub struct KcallRing {
+    /// Submission queue head (advanced by the kernel).
+    sq_head: u32,
+    /// Submission queue tail (advanced by user code).
+    sq_tail: u32,
+    /// Completion queue head (advanced by user code).
+    cq_head: u32,
+    /// Completion queue tail (advanced by the kernel).
+    cq_tail: u32,
+    /// Submission queue.
+    sq: [SubmissionEntry; KCALL_RING_LENGTH],
+    /// Completion queue.
+    cq: [CompletionEntry; KCALL_RING_LENGTH],
+}
+
+///
+/// **Description**
+///
+/// Builder for a batch of kernel calls.
+///
+pub struct KcallBatch<'a> {
+    /// Underlying kernel call ring.
+    ring: &'a mut KcallRing,
+    /// Number of kernel calls queued in this batch.
+    count: u32,
+}
+
+//==============================================================================
+// Implementations
+//==============================================================================
+
+impl KcallRing {
+    ///
+    /// **Description**
+    ///
+    /// Creates an empty kernel call ring.
+    ///
+    pub const fn new() -> Self {
+        Self {
+            sq_head: 0,
+            sq_tail: 0,
+            cq_head: 0,
+            cq_tail: 0,
+            sq: [SubmissionEntry {
+                kcall_nr: 0,
+                args: [0; 5],
+                tag: 0,
+            }; KCALL_RING_LENGTH],
+            cq: [CompletionEntry { tag: 0, ret: 0 }; KCALL_RING_LENGTH],
+        }
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Starts a new batch of kernel calls on the target ring.
+    ///
+    /// **Return**
+    ///
+    /// A builder for the new batch is returned.
+    ///
+    pub fn batch(&mut self) -> KcallBatch<'_> {
+        KcallBatch {
+            ring: self,
+            count: 0,
+        }
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Takes the oldest completion entry out of the completion queue.
+    ///
+    /// **Return**
+    ///
+    /// If the completion queue is not empty, the oldest completion entry is
+    /// returned. Otherwise, `None` is returned instead.
+    ///
+    pub fn complete(&mut self) -> Option<CompletionEntry> {
+        let cq_tail: u32 = unsafe { ptr::read_volatile(&self.cq_tail) };
+        if self.cq_head == cq_tail {
+            return None;
+        }
+
+        let index: usize = (self.cq_head as usize) & (KCALL_RING_LENGTH - 1);
+        let cqe: CompletionEntry =
+            unsafe { ptr::read_volatile(&self.cq[index]) };
+        self.cq_head = self.cq_head.wrapping_add(1);
+
+        Some(cqe)
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Returns the number of free slots in the submission queue.
+    ///
+    fn sq_space(&self) -> usize {
+        let sq_head: u32 = unsafe { ptr::read_volatile(&self.sq_head) };
+        KCALL_RING_LENGTH - (self.sq_tail.wrapping_sub(sq_head) as usize)
+    }
+}
+
+impl<'a> KcallBatch<'a> {
+    ///
+    /// **Description**
+    ///
+    /// Queues a kernel call in the target batch.
+    ///
+    /// **Parameters**
+    /// - `kcall_nr` - Kernel call number.
+    /// - `args` - Kernel call arguments (at most five).
+    /// - `tag` - Tag echoed in the completion entry.
+    ///
+    /// **Return**
+    ///
+    /// The target batch is returned, so that calls may be chained.
+    ///
+    /// **Panics**
+    ///
+    /// This function panics if the submission queue is full or if more than
+    /// five arguments are supplied.
+    ///
+    pub fn push(
+        &mut self,
+        kcall_nr: KcallNumbers,
+        args: &[u32],
+        tag: u32,
+    ) -> &mut Self {
+        assert!(args.len() <= 5, "too many kernel call arguments");
+        assert!(self.ring.sq_space() > 0, "kernel call ring is full");
+
+        let mut sqe: SubmissionEntry = SubmissionEntry {
+            kcall_nr: kcall_nr as u32,
+            args: [0; 5],
+            tag,
+        };
+        sqe.args[..args.len()].copy_from_slice(args);
+
+        let index: usize =
+            (self.ring.sq_tail as usize) & (KCALL_RING_LENGTH - 1);
+        unsafe {
+            ptr::write_volatile(&mut self.ring.sq[index], sqe);
+            ptr::write_volatile(
+                &mut self.ring.sq_tail,
+                self.ring.sq_tail.wrapping_add(1),
+            );
+        }
+        self.count += 1;
+
+        self
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Checks whether the submission queue is full.
+    ///
+    pub fn is_full(&self) -> bool {
+        self.ring.sq_space() == 0
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Submits all kernel calls queued in the target batch with a single trap.
+    /// Completions are then available through [`KcallRing::complete`].
+    ///
+    /// **Return**
+    ///
+    /// Upon successful completion, the number of kernel calls consumed by the
+    /// kernel is returned. Upon failure, a negative error code is returned
+    /// instead.
+    ///
+    pub fn submit(&mut self) -> i32 {
+        let count: u32 = self.count;
+        self.count = 0;
+        kcall_submit(self.ring, count)
+    }
+}
+
+//==============================================================================
+// Public Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Submits pending kernel calls in a kernel call ring.
+///
+/// **Parameters**
+/// - `ring` - Target kernel call ring.
+/// - `n` - Maximum number of kernel calls to submit.
+///
+/// **Return**
+///
+/// Upon successful completion, the number of kernel calls consumed by the
+/// kernel is returned. Upon failure, a negative error code is returned
+/// instead.
+///
+pub fn kcall_submit(ring: &mut KcallRing, n: u32) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::KcallSubmit as u32,
+            ring as *mut KcallRing as u32,
+            n,
+        ) as i32
+    }
+}
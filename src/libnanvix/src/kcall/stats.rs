@@ -0,0 +1,100 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+use super::{
+    kcall2,
+    KcallNumbers,
+};
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Number of buckets in a kernel call latency histogram.
+pub const KCALL_STATS_BUCKETS: usize = 32;
+
+/// Number of kernel calls tracked by the kernel.
+pub const KCALL_STATS_MAX: usize = KcallNumbers::LastKcall as usize;
+
+//==============================================================================
+// Structures
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Kernel call statistics. Bucket `i` of the latency histogram counts kernel
+/// calls that took [2^i, 2^(i+1)) cycles to complete, and the last bucket also
+/// counts kernel calls that took longer than that.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct KcallStats {
+    /// Number of invocations.
+    pub count: u32,
+    /// Number of failures.
+    pub errors: u32,
+    /// Latency histogram.
+    pub latency: [u32; KCALL_STATS_BUCKETS],
+}
+
+//==============================================================================
+// Trait Implementations
+//==============================================================================
+
+impl Default for KcallStats {
+    fn default() -> Self {
+        Self {
+            count: 0,
+            errors: 0,
+            latency: [0; KCALL_STATS_BUCKETS],
+        }
+    }
+}
+
+//==============================================================================
+// Public Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Gets a snapshot of kernel call statistics.
+///
+/// **Parameters**
+/// - `buf` - Storage location for statistics, indexed by kernel call number.
+///
+/// **Return**
+///
+/// Upon successful completion, the number of entries filled in `buf` is
+/// returned. Upon failure, a negative error code is returned instead.
+///
+pub fn stats(buf: &mut [KcallStats]) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::Stats as u32,
+            buf.as_mut_ptr() as u32,
+            buf.len() as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Gets the number of kernel calls that the kernel tracks statistics for.
+///
+/// **Return**
+///
+/// The number of kernel calls that the kernel tracks statistics for is
+/// returned.
+///
+pub fn stats_count() -> i32 {
+    unsafe { kcall2(KcallNumbers::Stats as u32, 0, 0) as i32 }
+}
@@ -13,6 +13,7 @@ use super::{
     kcall2,
     kcall3,
     kcall4,
+    kcall5,
     KcallNumbers,
 };
 
@@ -102,3 +103,23 @@ pub fn void3(arg0: u32, arg1: u32, arg2: u32) -> u32 {
 pub fn void4(arg0: u32, arg1: u32, arg2: u32, arg3: u32) -> u32 {
     unsafe { kcall4(KcallNumbers::Void4 as u32, arg0, arg1, arg2, arg3) }
 }
+
+///
+/// **Description**
+///
+/// Issues a void kernel call that takes five arguments.
+///
+/// **Parameters**
+/// - `arg0` - First argument for the kernel call.
+/// - `arg1` - Second argument for the kernel call.
+/// - `arg2` - Third argument for the kernel call.
+/// - `arg3` - Fourth argument for the kernel call.
+/// - `arg4` - Fifth argument for the kernel call.
+///
+/// **Return**
+///
+/// This function returns `arg0 + arg1 + arg2 + arg3 + arg4`
+///
+pub fn void5(arg0: u32, arg1: u32, arg2: u32, arg3: u32, arg4: u32) -> u32 {
+    unsafe { kcall5(KcallNumbers::Void5 as u32, arg0, arg1, arg2, arg3, arg4) }
+}
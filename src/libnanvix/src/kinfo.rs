@@ -0,0 +1,178 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+use crate::{
+    kcall::{
+        kcall0,
+        KcallNumbers,
+    },
+    pm::{
+        Pid,
+        Tid,
+    },
+};
+use core::{
+    ptr,
+    sync::atomic::{
+        self,
+        AtomicI32,
+        Ordering,
+    },
+};
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Base address of the kernel information page (see `KINFO_BASE_VIRT`).
+pub const KINFO_BASE_ADDRESS: u32 = 0x07bff000;
+
+//==============================================================================
+// Global Variables
+//==============================================================================
+
+/// Cached ID of the calling process (negative until it is known).
+static PID: AtomicI32 = AtomicI32::new(-1);
+
+//==============================================================================
+// Structures
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Kernel information. This structure is shared with the kernel: its layout
+/// must match `struct kinfo` in the kernel.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct KernelInfo {
+    /// Sequence number (odd while the kernel is updating this structure).
+    seq: u32,
+    /// ID of the running thread.
+    pub tid: Tid,
+    /// ID of the running process.
+    pub pid: Pid,
+    /// Number of free page frames.
+    pub free_frames: u32,
+    /// Number of timer ticks since system startup.
+    pub ticks: u64,
+    /// Number of cores that are online.
+    pub cores: u32,
+    /// Reserved.
+    reserved: u32,
+}
+
+//==============================================================================
+// Private Standalone Functions
+//==============================================================================
+
+/// Returns a pointer to the kernel information page.
+#[inline(always)]
+fn kinfo() -> *const KernelInfo {
+    KINFO_BASE_ADDRESS as *const KernelInfo
+}
+
+//==============================================================================
+// Public Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Takes a consistent snapshot of the kernel information page, without
+/// issuing a kernel call.
+///
+/// **Return**
+///
+/// A snapshot of the kernel information page is returned.
+///
+pub fn snapshot() -> KernelInfo {
+    loop {
+        // Wait for any ongoing update to complete.
+        let seq: u32 = unsafe { ptr::read_volatile(&(*kinfo()).seq) };
+        if (seq & 1) != 0 {
+            continue;
+        }
+        atomic::compiler_fence(Ordering::Acquire);
+
+        let info: KernelInfo = unsafe { ptr::read_volatile(kinfo()) };
+
+        // Retry if the kernel updated the page meanwhile.
+        atomic::compiler_fence(Ordering::Acquire);
+        if unsafe { ptr::read_volatile(&(*kinfo()).seq) } == seq {
+            return info;
+        }
+    }
+}
+
+///
+/// **Description**
+///
+/// Returns the ID of the calling thread. No kernel call is issued, unless more
+/// than one core is online.
+///
+pub fn thread_getid() -> Tid {
+    if cores() > 1 {
+        return unsafe { kcall0(KcallNumbers::ThreadGet as u32) as Tid };
+    }
+
+    unsafe { ptr::read_volatile(&(*kinfo()).tid) }
+}
+
+///
+/// **Description**
+///
+/// Returns the ID of the calling process. No kernel call is issued, unless more
+/// than one core is online. In that case, a kernel call is issued only once,
+/// and the result is cached afterwards.
+///
+pub fn process_getid() -> Pid {
+    if cores() > 1 {
+        let pid: Pid = PID.load(Ordering::Relaxed);
+        if pid >= 0 {
+            return pid;
+        }
+
+        let pid: Pid =
+            unsafe { kcall0(KcallNumbers::ProcessGet as u32) as Pid };
+        PID.store(pid, Ordering::Relaxed);
+        return pid;
+    }
+
+    unsafe { ptr::read_volatile(&(*kinfo()).pid) }
+}
+
+///
+/// **Description**
+///
+/// Returns the number of free page frames, without issuing a kernel call.
+///
+pub fn free_frames() -> u32 {
+    unsafe { ptr::read_volatile(&(*kinfo()).free_frames) }
+}
+
+///
+/// **Description**
+///
+/// Returns the number of cores that are online, without issuing a kernel call.
+///
+pub fn cores() -> u32 {
+    unsafe { ptr::read_volatile(&(*kinfo()).cores) }
+}
+
+///
+/// **Description**
+///
+/// Returns the number of timer ticks since system startup, without issuing a
+/// kernel call.
+///
+pub fn ticks() -> u64 {
+    snapshot().ticks
+}
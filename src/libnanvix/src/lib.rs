@@ -16,6 +16,7 @@ mod unwind;
 
 pub mod devices;
 pub mod kcall;
+pub mod kinfo;
 pub mod memory;
 pub mod misc;
 pub mod pm;
@@ -31,3 +32,25 @@ macro_rules! log{
 		let _ = write!(&mut Logger::get(module_path!()), $($arg)*);
 	})
 }
+
+///
+/// **Description**
+///
+/// Declares a key of a slot in the TLS block of the running thread. Each slot
+/// holds one word, which is read and written with a single segment-relative
+/// access.
+///
+/// **Example**
+///
+/// ```ignore
+/// nanvix::thread_local!(static COUNTER = 0;);
+/// COUNTER.set(COUNTER.get() + 1);
+/// ```
+///
+#[macro_export]
+macro_rules! thread_local{
+	( $(#[$attr:meta])* $vis:vis static $name:ident = $slot:expr; ) => (
+		$(#[$attr])* $vis static $name: $crate::pm::TlsKey =
+			$crate::pm::TlsKey::new($slot);
+	)
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Lowest thread priority.
+pub const THREAD_PRIO_MIN: i32 = 0;
+
+/// Highest thread priority.
+pub const THREAD_PRIO_MAX: i32 = 3;
+
+/// Default thread priority.
+pub const THREAD_PRIO_DEFAULT: i32 = 1;
+
+/// Adaptive thread quantum.
+pub const THREAD_QUANTUM_ADAPTIVE: u32 = 0;
+
+/// Shortest thread quantum (in timer ticks).
+pub const THREAD_QUANTUM_MIN: u32 = 1;
+
+/// Longest thread quantum (in timer ticks).
+pub const THREAD_QUANTUM_MAX: u32 = 100;
+
+/// Default thread quantum (in timer ticks).
+pub const THREAD_QUANTUM_DEFAULT: u32 = 10;
+
+/// Smallest user stack size (in bytes).
+pub const THREAD_STACK_SIZE_MIN: u32 = 4096;
+
+/// Largest user stack size (in bytes).
+pub const THREAD_STACK_SIZE_MAX: u32 = 63 * 4096;
+
+/// Default user stack size (in bytes).
+pub const THREAD_STACK_SIZE_DEFAULT: u32 = 16 * 4096;
+
+/// Longest real-time period (in timer ticks).
+pub const THREAD_RT_PERIOD_MAX: u32 = 1000;
+
+/// Lowest fair share weight.
+pub const THREAD_SHARE_WEIGHT_MIN: u32 = 1;
+
+/// Highest fair share weight.
+pub const THREAD_SHARE_WEIGHT_MAX: u32 = 10000;
+
+/// Default fair share weight.
+pub const THREAD_SHARE_WEIGHT_DEFAULT: u32 = 100;
+
+/// Longest fair share period (in timer ticks).
+pub const THREAD_SHARE_PERIOD_MAX: u32 = 1000;
+
+/// Largest bound of address space affinity.
+pub const THREAD_AFFINITY_MAX: u32 = 16;
+
+/// Number of slots in a TLS block.
+pub const TLS_SLOTS_MAX: usize = 16;
+
+/// Infinite timeout.
+pub const TIMEOUT_INFINITE: u32 = u32::MAX;
@@ -13,8 +13,10 @@ use crate::{
         kcall1,
         kcall2,
         kcall3,
+        kcall4,
         KcallNumbers,
     },
+    kinfo,
     pm::*,
 };
 use core::ffi;
@@ -102,16 +104,15 @@ pub fn semctl(id: u32, cmd: u32, val: u32) -> i32 {
 ///
 /// **Description**
 /// 
-/// Returns the ID of the calling thread.
+/// Returns the ID of the calling thread. This reads the kernel information
+/// page, thus no kernel call is issued.
 /// 
 /// **Return**
 /// 
 /// The ID of the calling thread is returned.
 /// 
 pub fn thread_getid() -> Tid {
-    unsafe { 
-        kcall0(KcallNumbers::ThreadGet as u32) as Tid
-    }
+    kinfo::thread_getid()
 }
 
 ///
@@ -138,6 +139,26 @@ pub fn thread_yield() -> () {
     }
 }
 
+///
+/// **Description**
+///
+/// Yields the CPU to a target thread, donating to it the remainder of the time
+/// slice of the calling thread.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned. If the target thread is not
+/// ready, the CPU is yielded as in `thread_yield()` and `-EAGAIN` is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_yield_to(tid: Tid) -> i32 {
+    unsafe { kcall1(KcallNumbers::ThreadYieldTo as u32, tid as u32) as i32 }
+}
+
 ///
 /// **Description**
 ///
@@ -154,8 +175,41 @@ pub fn thread_yield() -> () {
 /// Upon failure, a negative error code is returned instead.
 ///
 pub fn thread_create(func: fn(*mut ffi::c_void) -> *mut ffi::c_void, arg: *mut ffi::c_void) -> Tid {
-    unsafe { 
-        kcall3(KcallNumbers::ThreadCreate as u32, func as u32, arg as u32, thread_caller as u32) as Tid
+    thread_create_with_stack(func, arg, 0)
+}
+
+///
+/// **Description**
+///
+/// Creates a new thread with a user stack of a given size. The stack is
+/// reserved up front, but page frames are only taken as the stack grows. A
+/// thread that overflows its stack is terminated.
+///
+/// **Parameters**
+///
+/// - `func` - Function to run.
+/// - `arg`  - Argument to pass to the function.
+/// - `stacksize` - Size of the user stack (in bytes). If zero, the default size
+///   (`THREAD_STACK_SIZE_DEFAULT`) is used.
+///
+/// **Return**
+///
+/// Upon successful completion, the ID of the spawned thread is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_create_with_stack(
+    func: fn(*mut ffi::c_void) -> *mut ffi::c_void,
+    arg: *mut ffi::c_void,
+    stacksize: u32,
+) -> Tid {
+    unsafe {
+        kcall4(
+            KcallNumbers::ThreadCreate as u32,
+            func as u32,
+            arg as u32,
+            thread_caller as u32,
+            stacksize,
+        ) as Tid
     }
 }
 
@@ -180,6 +234,38 @@ pub fn thread_join(tid: Tid, retval: *mut *mut ffi::c_void) -> i32 {
     }
 }
 
+///
+/// **Description**
+///
+/// Waits for a thread to terminate, for at most a number of timer ticks.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `retval` - Location to store the return value of the target thread.
+/// - `ticks` - Maximum number of timer ticks to wait, or `TIMEOUT_INFINITE`.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned. If the target thread does
+/// not terminate in time, `-ETIMEDOUT` is returned. Upon failure, a negative
+/// error code is returned instead.
+///
+pub fn thread_join_timeout(
+    tid: Tid,
+    retval: *mut *mut ffi::c_void,
+    ticks: u32,
+) -> i32 {
+    unsafe {
+        kcall3(
+            KcallNumbers::ThreadJoinTimeout as u32,
+            tid as u32,
+            retval as u32,
+            ticks,
+        ) as i32
+    }
+}
+
 ///
 /// **Description**
 ///
@@ -198,4 +284,308 @@ pub fn thread_detach(tid: Tid) -> i32 {
     unsafe { 
         kcall1(KcallNumbers::ThreadDetach as u32, tid as u32) as i32
     }
-}
\ No newline at end of file
+}
+
+///
+/// **Description**
+///
+/// Sets the priority of a thread. Threads with higher priority are scheduled
+/// first, and threads with the same priority are scheduled in round-robin
+/// order.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `prio` - New priority (from `THREAD_PRIO_MIN` to `THREAD_PRIO_MAX`).
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_setprio(tid: Tid, prio: i32) -> i32 {
+    unsafe { kcall2(KcallNumbers::ThreadSetprio as u32, tid as u32, prio as u32) as i32 }
+}
+
+///
+/// **Description**
+///
+/// Gets the priority of a thread.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+///
+/// **Return**
+///
+/// Upon successful completion, the priority of the target thread is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_getprio(tid: Tid) -> i32 {
+    unsafe { kcall1(KcallNumbers::ThreadGetprio as u32, tid as u32) as i32 }
+}
+
+///
+/// **Description**
+///
+/// Sets the quantum of a thread, that is, the length of its time slices.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `quantum` - New quantum (in timer ticks), or `THREAD_QUANTUM_ADAPTIVE`.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_setquantum(tid: Tid, quantum: u32) -> i32 {
+    unsafe { kcall2(KcallNumbers::ThreadSetquantum as u32, tid as u32, quantum) as i32 }
+}
+
+///
+/// **Description**
+///
+/// Gets quantum information of a thread.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `info` - Storage location for quantum information.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_getquantum(tid: Tid, info: &mut ThreadQuantum) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ThreadGetquantum as u32,
+            tid as u32,
+            info as *mut ThreadQuantum as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Sets the real-time parameters of a thread. Real-time threads are scheduled
+/// by earliest deadline first, ahead of all other threads, and they are
+/// throttled once they overrun their budget in a period. A zero period moves
+/// the target thread back to the regular scheduling class.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `params` - New real-time parameters.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned. If the target thread is not
+/// admitted, `-EBUSY` is returned. Upon failure, a negative error code is
+/// returned instead.
+///
+pub fn thread_setrt(tid: Tid, params: &ThreadRt) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ThreadSetrt as u32,
+            tid as u32,
+            params as *const ThreadRt as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Gets the real-time parameters of a thread.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `params` - Storage location for real-time parameters.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_getrt(tid: Tid, params: &mut ThreadRt) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ThreadGetrt as u32,
+            tid as u32,
+            params as *mut ThreadRt as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Sets the bound of address space affinity of the scheduler. Under address
+/// space affinity, ready threads of the process that was last run on a core are
+/// preferred over older threads of the same priority, for at most `bound`
+/// times in a row. A zero bound turns address space affinity off.
+///
+/// **Parameters**
+///
+/// - `bound` - New bound.
+///
+/// **Return**
+///
+/// Upon successful completion, the previous bound is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn sched_affinity(bound: u32) -> i32 {
+    unsafe { kcall1(KcallNumbers::SchedAffinity as u32, bound) as i32 }
+}
+
+///
+/// **Description**
+///
+/// Sets the TLS block of the calling thread. Threads that are created with
+/// `thread_create()` get a TLS block on their own, thus this is only needed by
+/// the main thread of a process.
+///
+/// **Parameters**
+///
+/// - `block` - New TLS block. It must outlive its use by the calling thread.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_settls(block: &mut TlsBlock) -> i32 {
+    let this: *mut TlsBlock = block.bind();
+    unsafe { kcall1(KcallNumbers::ThreadSettls as u32, this as u32) as i32 }
+}
+
+///
+/// **Description**
+///
+/// Gets statistics of a thread. Threads of any process may be queried.
+///
+/// **Parameters**
+///
+/// - `tid` - ID of the target thread.
+/// - `stats` - Storage location for thread statistics.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn thread_stats(tid: Tid, stats: &mut ThreadStats) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ThreadStats as u32,
+            tid as u32,
+            stats as *mut ThreadStats as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Gets statistics of a process, which add up statistics of all its threads,
+/// including those that exited. Any process may be queried. Idle time is
+/// accounted to the kernel process.
+///
+/// **Parameters**
+///
+/// - `pid` - ID of the target process.
+/// - `stats` - Storage location for process statistics.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn process_stats(pid: Pid, stats: &mut ThreadStats) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ProcessStats as u32,
+            pid as u32,
+            stats as *mut ThreadStats as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Sets the fair share parameters of a process. Processes share the processor
+/// in proportion to their weights, regardless of how many threads they have.
+/// A process with a quota runs at most `quota` timer ticks in every `period`,
+/// and its threads are throttled until the next period once it overruns it.
+///
+/// **Parameters**
+///
+/// - `pid` - ID of the target process.
+/// - `params` - New fair share parameters. A zero quota lifts the cap of the
+///   target process.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn process_setshare(pid: Pid, params: &ThreadShare) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ProcessSetshare as u32,
+            pid as u32,
+            params as *const ThreadShare as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Gets the fair share parameters of a process. Any process may be queried.
+///
+/// **Parameters**
+///
+/// - `pid` - ID of the target process.
+/// - `params` - Storage location for fair share parameters.
+///
+/// **Return**
+///
+/// Upon successful completion, zero is returned.
+/// Upon failure, a negative error code is returned instead.
+///
+pub fn process_getshare(pid: Pid, params: &mut ThreadShare) -> i32 {
+    unsafe {
+        kcall2(
+            KcallNumbers::ProcessGetshare as u32,
+            pid as u32,
+            params as *mut ThreadShare as u32,
+        ) as i32
+    }
+}
+
+///
+/// **Description**
+///
+/// Puts the calling thread to sleep for a number of timer ticks, without
+/// using the processor meanwhile. If `ticks` is zero, the calling thread only
+/// yields the processor.
+///
+/// **Parameters**
+///
+/// - `ticks` - Number of timer ticks to sleep.
+///
+/// **Return**
+///
+/// Zero is always returned.
+///
+pub fn sleep(ticks: u32) -> i32 {
+    unsafe { kcall1(KcallNumbers::Sleep as u32, ticks) as i32 }
+}
@@ -7,7 +7,9 @@
 // Modules
 //==============================================================================
 
+mod constants;
 mod kcall;
+mod tls;
 mod types;
 
 //==============================================================================
@@ -15,7 +17,9 @@ mod types;
 //==============================================================================
 
 pub use self::{
+    constants::*,
     kcall::*,
+    tls::*,
     types::*,
 };
 pub use core::ffi;
@@ -38,9 +42,12 @@ use crate::log;
 
 /// **Description**
 ///
-/// Executes the return of a user-created thread.
+/// Executes the return of a user-created thread. The TLS block of the thread
+/// lives in this stack frame, which outlives the thread function.
 ///
 pub(crate) fn thread_caller(start: fn (*mut ffi::c_void) -> *mut ffi::c_void, arg: *mut ffi::c_void) -> ! {
+    let mut tls: TlsBlock = TlsBlock::new();
+    thread_settls(&mut tls);
     let ret = start(arg);
     unsafe { kcall1(KcallNumbers::ThreadExit as u32, ret as u32) };
     loop {}
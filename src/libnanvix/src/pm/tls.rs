@@ -0,0 +1,181 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+use super::constants::TLS_SLOTS_MAX;
+use core::{
+    arch,
+    mem,
+    ptr,
+};
+
+//==============================================================================
+// Structures
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Thread-local storage (TLS) block. The kernel loads the TLS block of the
+/// running thread as the base of the `gs` segment, thus each slot is read and
+/// written with a single segment-relative access. The first word points to the
+/// TLS block itself.
+///
+#[repr(C)]
+#[derive(Debug)]
+pub struct TlsBlock {
+    /// Location of this TLS block.
+    this: *mut TlsBlock,
+    /// Slots.
+    slots: [usize; TLS_SLOTS_MAX],
+}
+
+///
+/// **Description**
+///
+/// Key of a slot in the TLS block of the running thread. Keys are declared
+/// with the `thread_local!` macro.
+///
+#[derive(Debug)]
+pub struct TlsKey {
+    /// Offset of the slot in the TLS block.
+    offset: usize,
+}
+
+//==============================================================================
+// Implementations
+//==============================================================================
+
+impl TlsBlock {
+    ///
+    /// **Description**
+    ///
+    /// Creates an empty TLS block.
+    ///
+    pub const fn new() -> Self {
+        Self {
+            this: ptr::null_mut(),
+            slots: [0; TLS_SLOTS_MAX],
+        }
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Points the first word of this TLS block to itself. This is done right
+    /// before the TLS block is handed over to the kernel.
+    ///
+    pub(crate) fn bind(&mut self) -> *mut TlsBlock {
+        self.this = self as *mut TlsBlock;
+        self.this
+    }
+}
+
+impl TlsKey {
+    ///
+    /// **Description**
+    ///
+    /// Creates a key for the slot `slot` of TLS blocks.
+    ///
+    /// **Parameters**
+    ///
+    /// - `slot` - Target slot. It must be lower than `TLS_SLOTS_MAX`.
+    ///
+    pub const fn new(slot: usize) -> Self {
+        assert!(slot < TLS_SLOTS_MAX);
+        Self {
+            offset: mem::size_of::<*mut TlsBlock>()
+                + slot * mem::size_of::<usize>(),
+        }
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Reads the slot of this key in the TLS block of the running thread.
+    ///
+    /// **Return**
+    ///
+    /// The value of the target slot.
+    ///
+    /// **Notes**
+    ///
+    /// The running thread must have a TLS block. Otherwise, it faults.
+    ///
+    #[inline(always)]
+    pub fn get(&self) -> usize {
+        let value: usize;
+        unsafe {
+            arch::asm!("mov {0}, gs:[{1}]",
+                out(reg) value,
+                in(reg) self.offset,
+                options(nostack, readonly, preserves_flags)
+            );
+        }
+        value
+    }
+
+    ///
+    /// **Description**
+    ///
+    /// Writes the slot of this key in the TLS block of the running thread.
+    ///
+    /// **Parameters**
+    ///
+    /// - `value` - Value to write.
+    ///
+    /// **Notes**
+    ///
+    /// The running thread must have a TLS block. Otherwise, it faults.
+    ///
+    #[inline(always)]
+    pub fn set(&self, value: usize) {
+        unsafe {
+            arch::asm!("mov gs:[{1}], {0}",
+                in(reg) value,
+                in(reg) self.offset,
+                options(nostack, preserves_flags)
+            );
+        }
+    }
+}
+
+impl Default for TlsBlock {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+//==============================================================================
+// Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Gets the TLS block of the running thread.
+///
+/// **Return**
+///
+/// A pointer to the TLS block of the running thread.
+///
+/// **Notes**
+///
+/// The running thread must have a TLS block. Otherwise, it faults.
+///
+#[inline(always)]
+pub fn tls_block() -> *mut TlsBlock {
+    let this: *mut TlsBlock;
+    unsafe {
+        arch::asm!("mov {0}, gs:[0]",
+            out(reg) this,
+            options(nostack, readonly, preserves_flags)
+        );
+    }
+    this
+}
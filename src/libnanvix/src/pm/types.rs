@@ -12,3 +12,95 @@ pub type Pid = i32;
 
 /// Thread ID
 pub type Tid = i32;
+
+//==============================================================================
+// Structures
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Thread quantum information. This structure is shared with the kernel: its
+/// layout must match `struct thread_quantum` in the kernel.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct ThreadQuantum {
+    /// Time slice (in timer ticks).
+    pub quantum: u32,
+    /// Adaptive time slice?
+    pub adaptive: u32,
+    /// Number of time slices used.
+    pub slices_used: u32,
+    /// Number of time slices that expired.
+    pub slices_expired: u32,
+}
+
+///
+/// **Description**
+///
+/// Thread statistics. Times are measured in processor cycles. This structure
+/// is shared with the kernel: its layout must match `struct thread_stats` in
+/// the kernel.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default)]
+pub struct ThreadStats {
+    /// Time spent in user mode.
+    pub user_cycles: u64,
+    /// Time spent in kernel calls.
+    pub kernel_cycles: u64,
+    /// Time spent ready, but not running.
+    pub ready_cycles: u64,
+    /// Time spent idling.
+    pub idle_cycles: u64,
+    /// Number of voluntary context switches.
+    pub nvcsw: u32,
+    /// Number of involuntary context switches.
+    pub nivcsw: u32,
+    /// Number of deadlines missed.
+    pub misses: u32,
+    /// Number of budgets overrun.
+    pub throttles: u32,
+    /// Number of switches to the thread that kept the address space.
+    pub as_same: u32,
+    /// Number of switches to the thread that loaded another address space.
+    pub as_cross: u32,
+}
+
+///
+/// **Description**
+///
+/// Real-time parameters of a thread. Times are measured in timer ticks, and a
+/// zero period stands for the regular scheduling class. This structure is
+/// shared with the kernel: its layout must match `struct thread_rt` in the
+/// kernel.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default, PartialEq, Eq)]
+pub struct ThreadRt {
+    /// Period.
+    pub period: u32,
+    /// Budget in each period.
+    pub budget: u32,
+    /// Deadline, relative to the start of each period.
+    pub deadline: u32,
+}
+
+///
+/// **Description**
+///
+/// Fair share parameters of a process. Times are measured in timer ticks, and
+/// a zero quota stands for no cap. This structure is shared with the kernel:
+/// its layout must match `struct thread_share` in the kernel.
+///
+#[repr(C)]
+#[derive(Debug, Copy, Clone, Default, PartialEq, Eq)]
+pub struct ThreadShare {
+    /// Weight.
+    pub weight: u32,
+    /// Ticks that the process may run in each period.
+    pub quota: u32,
+    /// Period.
+    pub period: u32,
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+use core::{
+    arch::x86,
+    ffi,
+    ptr,
+};
+use nanvix::{
+    kcall,
+    memory::{
+        self,
+        FrameNumber,
+        VirtualMemory,
+    },
+    pm::{
+        self,
+        Tid,
+    },
+};
+
+//==============================================================================
+// Constants
+//==============================================================================
+
+/// Default number of iterations for each benchmark.
+const DEFAULT_ITERATIONS: usize = 256;
+
+/// Maximum number of iterations for each benchmark.
+const MAX_ITERATIONS: usize = 1024;
+
+/// Number of warm-up iterations for each benchmark.
+const WARMUP_ITERATIONS: usize = 16;
+
+/// Number of iterations for each benchmark (set with NANVIX_BENCH_ITERATIONS).
+const ITERATIONS: usize =
+    parse_iterations(option_env!("NANVIX_BENCH_ITERATIONS"));
+
+//==============================================================================
+// Global Variables
+//==============================================================================
+
+/// Samples of the running benchmark.
+static mut SAMPLES: [u64; MAX_ITERATIONS] = [0; MAX_ITERATIONS];
+
+//==============================================================================
+// Private Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Parses the number of iterations for each benchmark at compile time.
+///
+/// **Parameters**
+/// - `s` - Number of iterations, in decimal.
+///
+/// **Return**
+///
+/// The number of iterations, clamped to `MAX_ITERATIONS`, is returned. If `s`
+/// is missing or invalid, `DEFAULT_ITERATIONS` is returned instead.
+///
+const fn parse_iterations(s: Option<&str>) -> usize {
+    let bytes: &[u8] = match s {
+        Some(s) => s.as_bytes(),
+        None => return DEFAULT_ITERATIONS,
+    };
+
+    let mut n: usize = 0;
+    let mut i: usize = 0;
+    while i < bytes.len() {
+        if (bytes[i] < b'0') || (bytes[i] > b'9') {
+            return DEFAULT_ITERATIONS;
+        }
+        n = n * 10 + ((bytes[i] - b'0') as usize);
+        if n > MAX_ITERATIONS {
+            return MAX_ITERATIONS;
+        }
+        i += 1;
+    }
+
+    if n == 0 {
+        DEFAULT_ITERATIONS
+    } else {
+        n
+    }
+}
+
+/// Reads the timestamp counter.
+#[inline(always)]
+fn rdtsc() -> u64 {
+    unsafe { x86::_rdtsc() }
+}
+
+///
+/// **Description**
+///
+/// Runs a benchmark and prints its results on the standard output, in the
+/// following format:
+///
+/// `kcall=<name> iterations=<n> min=<cycles> median=<cycles> p99=<cycles>`
+///
+/// **Parameters**
+/// - `name` - Name of the benchmark.
+/// - `sample` - Function that takes one sample, in cycles. It returns `None`
+///   if the underlying kernel call failed.
+///
+fn bench<F: FnMut() -> Option<u64>>(name: &str, mut sample: F) {
+    let samples: &mut [u64] = unsafe { &mut SAMPLES[..ITERATIONS] };
+
+    // Warm up caches and TLBs.
+    for _ in 0..WARMUP_ITERATIONS {
+        if sample().is_none() {
+            nanvix::log!("kcall={} error=failed", name);
+            return;
+        }
+    }
+
+    for i in 0..ITERATIONS {
+        match sample() {
+            Some(cycles) => samples[i] = cycles,
+            None => {
+                nanvix::log!("kcall={} error=failed", name);
+                return;
+            },
+        }
+    }
+
+    samples.sort_unstable();
+    let n: usize = samples.len();
+    nanvix::log!(
+        "kcall={} iterations={} min={} median={} p99={}",
+        name,
+        n,
+        samples[0],
+        samples[n / 2],
+        samples[(n * 99 + 99) / 100 - 1]
+    );
+}
+
+/// Entry point of threads spawned by thread benchmarks.
+fn thread_noop(_arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    ptr::null_mut()
+}
+
+/// Times void kernel calls, which measures the raw trap cost.
+fn bench_void() {
+    bench("void0", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void0();
+        let end: u64 = rdtsc();
+        (ret == 0).then_some(end - start)
+    });
+    bench("void1", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void1(1);
+        let end: u64 = rdtsc();
+        (ret == 1).then_some(end - start)
+    });
+    bench("void2", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void2(1, 2);
+        let end: u64 = rdtsc();
+        (ret == 3).then_some(end - start)
+    });
+    bench("void3", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void3(1, 2, 3);
+        let end: u64 = rdtsc();
+        (ret == 6).then_some(end - start)
+    });
+    bench("void4", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void4(1, 2, 3, 4);
+        let end: u64 = rdtsc();
+        (ret == 10).then_some(end - start)
+    });
+    bench("void5", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = kcall::void5(1, 2, 3, 4, 5);
+        let end: u64 = rdtsc();
+        (ret == 15).then_some(end - start)
+    });
+}
+
+/// Times page frame kernel calls.
+fn bench_frame() {
+    bench("fralloc", || {
+        let start: u64 = rdtsc();
+        let frame: FrameNumber = memory::fralloc();
+        let end: u64 = rdtsc();
+        if (frame == memory::NULL_FRAME) || (memory::frfree(frame) != 0) {
+            return None;
+        }
+        Some(end - start)
+    });
+    bench("frfree", || {
+        let frame: FrameNumber = memory::fralloc();
+        if frame == memory::NULL_FRAME {
+            return None;
+        }
+        let start: u64 = rdtsc();
+        let ret: u32 = memory::frfree(frame);
+        let end: u64 = rdtsc();
+        (ret == 0).then_some(end - start)
+    });
+}
+
+/// Times virtual memory kernel calls.
+fn bench_vmem() {
+    bench("vmcreate", || {
+        let start: u64 = rdtsc();
+        let vmem: VirtualMemory = memory::vmcreate();
+        let end: u64 = rdtsc();
+        if (vmem == memory::NULL_VMEM) || (memory::vmremove(vmem) != 0) {
+            return None;
+        }
+        Some(end - start)
+    });
+    bench("vmremove", || {
+        let vmem: VirtualMemory = memory::vmcreate();
+        if vmem == memory::NULL_VMEM {
+            return None;
+        }
+        let start: u64 = rdtsc();
+        let ret: u32 = memory::vmremove(vmem);
+        let end: u64 = rdtsc();
+        (ret == 0).then_some(end - start)
+    });
+
+    // Set up a virtual memory space and a page frame for mapping benchmarks.
+    let vmem: VirtualMemory = memory::vmcreate();
+    if vmem == memory::NULL_VMEM {
+        nanvix::log!("kcall=vmmap error=failed");
+        return;
+    }
+    let frame: FrameNumber = memory::fralloc();
+    if frame == memory::NULL_FRAME {
+        nanvix::log!("kcall=vmmap error=failed");
+        memory::vmremove(vmem);
+        return;
+    }
+
+    let vaddr: u32 = memory::USER_BASE_ADDRESS;
+    bench("vmmap", || {
+        let start: u64 = rdtsc();
+        let ret: u32 = memory::vmmap(vmem, vaddr, frame);
+        let end: u64 = rdtsc();
+        if (ret != 0) || (memory::vmunmap(vmem, vaddr) != frame) {
+            return None;
+        }
+        Some(end - start)
+    });
+    bench("vmunmap", || {
+        if memory::vmmap(vmem, vaddr, frame) != 0 {
+            return None;
+        }
+        let start: u64 = rdtsc();
+        let ret: u32 = memory::vmunmap(vmem, vaddr);
+        let end: u64 = rdtsc();
+        (ret == frame).then_some(end - start)
+    });
+
+    memory::frfree(frame);
+    memory::vmremove(vmem);
+}
+
+/// Times thread management kernel calls.
+fn bench_thread() {
+    bench("thread_create", || {
+        let start: u64 = rdtsc();
+        let tid: Tid = pm::thread_create(thread_noop, ptr::null_mut());
+        let end: u64 = rdtsc();
+        let mut retval: *mut ffi::c_void = ptr::null_mut();
+        if (tid < 0) || (pm::thread_join(tid, &mut retval) != 0) {
+            return None;
+        }
+        Some(end - start)
+    });
+    bench("thread_join", || {
+        let tid: Tid = pm::thread_create(thread_noop, ptr::null_mut());
+        if tid < 0 {
+            return None;
+        }
+        let mut retval: *mut ffi::c_void = ptr::null_mut();
+        let start: u64 = rdtsc();
+        let ret: i32 = pm::thread_join(tid, &mut retval);
+        let end: u64 = rdtsc();
+        (ret == 0).then_some(end - start)
+    });
+    bench("thread_yield", || {
+        let start: u64 = rdtsc();
+        pm::thread_yield();
+        let end: u64 = rdtsc();
+        Some(end - start)
+    });
+}
+
+//==============================================================================
+// Public Standalone Functions
+//==============================================================================
+
+///
+/// **Description**
+///
+/// Times kernel calls and prints their latency, in cycles, on the standard
+/// output.
+///
+pub fn bench_kernel_calls() {
+    bench_void();
+    bench_frame();
+    bench_vmem();
+    bench_thread();
+}
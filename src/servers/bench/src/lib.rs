@@ -0,0 +1,32 @@
+/*
+ * Copyright(c) 2011-2024 The Maintainers of Nanvix.
+ * Licensed under the MIT License.
+ */
+
+#![no_std]
+#![feature(panic_info_message)]
+
+//==============================================================================
+// Modules
+//==============================================================================
+
+mod bench;
+
+//==============================================================================
+// Imports
+//==============================================================================
+
+extern crate nanvix;
+
+use nanvix::power;
+
+//==============================================================================
+// Standalone Functions
+//==============================================================================
+
+#[no_mangle]
+pub fn main() {
+    nanvix::log!("Running bench server...");
+    bench::bench_kernel_calls();
+    power::shutdown();
+}
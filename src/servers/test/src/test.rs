@@ -8,7 +8,12 @@
 //==============================================================================
 
 use nanvix::{
+    devices,
     kcall,
+    kinfo::{
+        self,
+        KernelInfo,
+    },
     memory::{
         self,
         FrameNumber,
@@ -77,6 +82,236 @@ fn issue_void4_kcall() -> bool {
     kcall::void4(1, 2, 3, 4) == 10
 }
 
+/// Issues a void5 kernel call.
+fn issue_void5_kcall() -> bool {
+    kcall::void5(1, 2, 3, 4, 5) == 15
+}
+
+/// Issues a batch of void kernel calls through a kernel call ring.
+fn issue_kcall_batch() -> bool {
+    static mut RING: kcall::KcallRing = kcall::KcallRing::new();
+    let ring: &mut kcall::KcallRing = unsafe { &mut RING };
+
+    // Submit a batch of kernel calls.
+    let result: i32 = ring
+        .batch()
+        .push(kcall::KcallNumbers::Void0, &[], 0)
+        .push(kcall::KcallNumbers::Void2, &[1, 2], 1)
+        .push(kcall::KcallNumbers::Void4, &[1, 2, 3, 4], 2)
+        .submit();
+
+    // Check if we failed to submit the batch.
+    if result != 3 {
+        nanvix::log!("failed to submit kernel call batch (result={})", result);
+        return false;
+    }
+
+    // Check completions.
+    let expected: [i32; 3] = [0, 3, 10];
+    for (tag, ret) in expected.iter().enumerate() {
+        match ring.complete() {
+            Some(cqe) if (cqe.tag == tag as u32) && (cqe.ret == *ret) => {},
+            _ => {
+                nanvix::log!("unexpected kernel call completion (tag={})", tag);
+                return false;
+            },
+        }
+    }
+
+    // Check if we got a spurious completion.
+    if ring.complete().is_some() {
+        nanvix::log!("spurious kernel call completion");
+        return false;
+    }
+
+    true
+}
+
+/// Attempts to issue blocking kernel calls through a kernel call ring.
+fn issue_blocking_kcall_batch() -> bool {
+    static mut RING: kcall::KcallRing = kcall::KcallRing::new();
+    let ring: &mut kcall::KcallRing = unsafe { &mut RING };
+
+    // Submit a batch of kernel calls that may switch the caller out.
+    let result: i32 = ring
+        .batch()
+        .push(kcall::KcallNumbers::Sleep, &[1], 0)
+        .push(kcall::KcallNumbers::ThreadYield, &[], 1)
+        .submit();
+
+    // Check if we failed to submit the batch.
+    if result != 2 {
+        nanvix::log!("failed to submit kernel call batch (result={})", result);
+        return false;
+    }
+
+    // Check if blocking kernel calls were rejected.
+    let enotsup: i32 = 58; // 58 is the ENOTSUP error code
+    for tag in 0..2 {
+        match ring.complete() {
+            Some(cqe) if (cqe.tag == tag) && (cqe.ret == -enotsup) => {},
+            _ => {
+                nanvix::log!("blocking kernel call was issued (tag={})", tag);
+                return false;
+            },
+        }
+    }
+
+    true
+}
+
+/// Attempts to issue memory management kernel calls through a kernel call ring.
+fn issue_memory_kcall_batch() -> bool {
+    static mut RING: kcall::KcallRing = kcall::KcallRing::new();
+    let ring: &mut kcall::KcallRing = unsafe { &mut RING };
+
+    // Attempt to create a virtual memory space.
+    let vmem: VirtualMemory = memory::vmcreate();
+
+    // Check if we failed to create a virtual memory space.
+    if vmem == memory::NULL_VMEM {
+        nanvix::log!("failed to create a virtual memory space");
+        return false;
+    }
+
+    // Attempt to allocate a page frame.
+    let frame: FrameNumber = memory::fralloc();
+
+    // Check if we failed to allocate a page frame.
+    if frame == memory::NULL_FRAME {
+        nanvix::log!("failed to allocate a page frame");
+        return false;
+    }
+
+    // Submit a batch of memory management kernel calls.
+    let mode: AccessMode = AccessMode::new(false, true, false);
+    let request: VmCtrlRequest =
+        VmCtrlRequest::ChangePermissions(memory::USER_BASE_ADDRESS, mode);
+    let result: i32 = ring
+        .batch()
+        .push(kcall::KcallNumbers::FrameAlloc, &[], 0)
+        .push(
+            kcall::KcallNumbers::VmemMap,
+            &[vmem as u32, memory::USER_BASE_ADDRESS, frame],
+            1,
+        )
+        .push(
+            kcall::KcallNumbers::VmemControl,
+            &[
+                vmem as u32,
+                request.into(),
+                memory::USER_BASE_ADDRESS,
+                mode.into(),
+            ],
+            2,
+        )
+        .submit();
+
+    // Check if we failed to submit the batch.
+    if result != 3 {
+        nanvix::log!("failed to submit kernel call batch (result={})", result);
+        return false;
+    }
+
+    // Check if we failed to allocate a page frame from the batch.
+    let other: FrameNumber = match ring.complete() {
+        Some(cqe) if (cqe.tag == 0) && (cqe.ret > 0) => cqe.ret as u32,
+        _ => {
+            nanvix::log!("failed to allocate a page frame from a batch");
+            return false;
+        },
+    };
+
+    // Check if we failed to map and change permissions from the batch.
+    for tag in 1..3 {
+        match ring.complete() {
+            Some(cqe) if (cqe.tag == tag) && (cqe.ret == 0) => {},
+            _ => {
+                nanvix::log!("unexpected kernel call completion (tag={})", tag);
+                return false;
+            },
+        }
+    }
+
+    // Check if page has expected information.
+    let mut pageinfo: PageInfo = PageInfo::default();
+    if memory::vminfo(vmem, memory::USER_BASE_ADDRESS, &mut pageinfo) != 0 {
+        nanvix::log!("failed to get information on page");
+        return false;
+    }
+    if (pageinfo.frame != frame) || !pageinfo.mode.write() {
+        nanvix::log!("page has unexpected information");
+        return false;
+    }
+
+    // Release resources.
+    if memory::vmunmap(vmem, memory::USER_BASE_ADDRESS) != frame {
+        nanvix::log!("failed to unmap a page frame");
+        return false;
+    }
+    if (memory::frfree(frame) != 0) || (memory::frfree(other) != 0) {
+        nanvix::log!("failed to release a page frame");
+        return false;
+    }
+    if memory::vmremove(vmem) != 0 {
+        nanvix::log!("failed to remove a virtual memory space");
+        return false;
+    }
+
+    true
+}
+
+/// Writes a buffer that is larger than a single line to the standard output.
+fn write_large_buffer() -> bool {
+    let mut buf: [u8; 512] = [b'.'; 512];
+    buf[511] = b'\n';
+
+    // Attempt to write the whole buffer at once.
+    let result: u32 = devices::write(0, buf.as_ptr(), buf.len());
+
+    // Check if we failed to write the whole buffer.
+    if result != (buf.len() as u32) {
+        nanvix::log!("failed to write a large buffer");
+        return false;
+    }
+
+    true
+}
+
+/// Retrieves kernel call statistics.
+fn get_kcall_stats() -> bool {
+    let mut stats: [kcall::KcallStats; kcall::KCALL_STATS_MAX] =
+        [kcall::KcallStats::default(); kcall::KCALL_STATS_MAX];
+
+    // Check if kernel call numbers are out of sync with the kernel.
+    if kcall::stats_count() != (kcall::KCALL_STATS_MAX as i32) {
+        nanvix::log!("kernel call count mismatch");
+        return false;
+    }
+
+    // Issue a kernel call, so that it shows up in statistics.
+    kcall::void0();
+
+    // Attempt to get kernel call statistics.
+    let result: i32 = kcall::stats(&mut stats);
+
+    // Check if we failed to get kernel call statistics.
+    if result != (kcall::KCALL_STATS_MAX as i32) {
+        nanvix::log!("failed to get kernel call statistics");
+        return false;
+    }
+
+    // Check if statistics are consistent.
+    let void0: &kcall::KcallStats = &stats[kcall::KcallNumbers::Void0 as usize];
+    let samples: u32 = void0.latency.iter().sum();
+    if (void0.count == 0) || (samples != void0.count) || (void0.errors != 0) {
+        nanvix::log!("inconsistent kernel call statistics");
+        return false;
+    }
+
+    true
+}
+
 /// Attempts to allocate and release page frame.
 fn alloc_free_frame() -> bool {
     // Attempt to allocate a page frame.
@@ -263,6 +498,50 @@ fn map_unmap_vmem() -> bool {
     true
 }
 
+/// Attempts to unmap and change permissions on the kernel information page.
+fn unmap_kinfo_page() -> bool {
+    // Attempt to create a virtual memory space.
+    let vmem: VirtualMemory = memory::vmcreate();
+
+    // Check if we failed to create a virtual memory space.
+    if vmem == memory::NULL_VMEM {
+        nanvix::log!("failed to create a virtual memory space");
+        return false;
+    }
+
+    // Attempt to change access permissions on the kernel information page.
+    let mode: AccessMode = AccessMode::new(true, true, false);
+    let request: VmCtrlRequest =
+        VmCtrlRequest::ChangePermissions(kinfo::KINFO_BASE_ADDRESS, mode);
+    let result: u32 = memory::vmctrl(vmem, request);
+
+    // Check if we succeeded to change access permissions.
+    if result == 0 {
+        nanvix::log!("succeeded to change kernel information page");
+        return false;
+    }
+
+    // Attempt to unmap the kernel information page.
+    let result: u32 = memory::vmunmap(vmem, kinfo::KINFO_BASE_ADDRESS);
+
+    // Check if we succeeded to unmap the kernel information page.
+    if result != memory::NULL_FRAME {
+        nanvix::log!("succeeded to unmap kernel information page");
+        return false;
+    }
+
+    // Attempt to remove the virtual memory space.
+    let result: u32 = memory::vmremove(vmem);
+
+    // Check if we failed to remove the virtual memory space.
+    if result != 0 {
+        nanvix::log!("failed to remove a valid virtual memory space");
+        return false;
+    }
+
+    true
+}
+
 /// Checks if sizes are conformant.
 fn check_sizes() -> bool {
     if core::mem::size_of::<AccessMode>() != 4 {
@@ -293,6 +572,26 @@ fn check_sizes() -> bool {
         nanvix::log!("unexpected size for KernelModule");
         return false;
     }
+    if core::mem::size_of::<KernelInfo>() != 32 {
+        nanvix::log!("unexpected size for KernelInfo");
+        return false;
+    }
+    if core::mem::size_of::<pm::ThreadQuantum>() != 16 {
+        nanvix::log!("unexpected size for ThreadQuantum");
+        return false;
+    }
+    if core::mem::size_of::<pm::ThreadStats>() != 56 {
+        nanvix::log!("unexpected size for ThreadStats");
+        return false;
+    }
+    if core::mem::size_of::<pm::ThreadRt>() != 12 {
+        nanvix::log!("unexpected size for ThreadRt");
+        return false;
+    }
+    if core::mem::size_of::<pm::ThreadShare>() != 12 {
+        nanvix::log!("unexpected size for ThreadShare");
+        return false;
+    }
 
     true
 }
@@ -480,6 +779,33 @@ fn test_semctl_call() -> bool {
     true
 }
 
+/// Reads the kernel information page.
+fn read_kernel_info() -> bool {
+    let tid: Tid = unsafe {
+        kcall::kcall0(kcall::KcallNumbers::ThreadGet as u32) as Tid
+    };
+
+    // Check if the kernel information page agrees with the kernel. The running
+    // thread is only published there if a single core is online.
+    let info: KernelInfo = kinfo::snapshot();
+    let single_core: bool = info.cores == 1;
+    if (info.cores == 0)
+        || (single_core && ((info.tid != tid) || (info.pid <= 0)))
+        || (info.free_frames == 0)
+    {
+        nanvix::log!("inconsistent kernel information page");
+        return false;
+    }
+
+    // Check if the timer tick count does not go backwards.
+    if kinfo::ticks() < info.ticks {
+        nanvix::log!("timer tick count went backwards");
+        return false;
+    }
+
+    true
+}
+
 fn test_thread_getid() -> bool {
     let result: Tid = pm::thread_getid();
     if result < 0 {
@@ -489,6 +815,597 @@ fn test_thread_getid() -> bool {
     true
 }
 
+fn test_thread_prio() -> bool {
+    let tid: Tid = pm::thread_getid();
+
+    if pm::thread_getprio(tid) != pm::THREAD_PRIO_DEFAULT {
+        nanvix::log!("unexpected default thread priority");
+        return false;
+    }
+
+    if pm::thread_setprio(tid, pm::THREAD_PRIO_MAX) != 0 {
+        nanvix::log!("failed to set thread priority");
+        return false;
+    }
+
+    if pm::thread_getprio(tid) != pm::THREAD_PRIO_MAX {
+        nanvix::log!("thread priority was not updated");
+        return false;
+    }
+
+    if pm::thread_setprio(tid, pm::THREAD_PRIO_MAX + 1) >= 0 {
+        nanvix::log!("succeeded to set invalid thread priority");
+        return false;
+    }
+
+    if pm::thread_setprio(tid, pm::THREAD_PRIO_DEFAULT) != 0 {
+        nanvix::log!("failed to restore thread priority");
+        return false;
+    }
+
+    true
+}
+
+fn test_thread_stats() -> bool {
+    let tid: Tid = pm::thread_getid();
+    let mut before: pm::ThreadStats = pm::ThreadStats::default();
+    let mut after: pm::ThreadStats = pm::ThreadStats::default();
+
+    if pm::thread_stats(tid, &mut before) != 0 {
+        nanvix::log!("failed to get thread statistics");
+        return false;
+    }
+
+    if pm::thread_stats(tid, &mut after) != 0 {
+        nanvix::log!("failed to get thread statistics");
+        return false;
+    }
+
+    // The calling thread runs both in user mode and in kernel calls.
+    if (after.user_cycles == 0) || (after.kernel_cycles <= before.kernel_cycles)
+    {
+        nanvix::log!("thread time was not accounted");
+        return false;
+    }
+
+    if after.idle_cycles != 0 {
+        nanvix::log!("unexpected idle time for a user thread");
+        return false;
+    }
+
+    // The calling thread was switched to at least once.
+    if (after.as_same + after.as_cross) == 0 {
+        nanvix::log!("context switches were not accounted");
+        return false;
+    }
+
+    if pm::thread_stats(-1, &mut after) >= 0 {
+        nanvix::log!("succeeded to get statistics of an invalid thread");
+        return false;
+    }
+
+    // Process statistics add up those of its threads.
+    if kinfo::cores() == 1 {
+        let mut process: pm::ThreadStats = pm::ThreadStats::default();
+        if pm::process_stats(kinfo::process_getid(), &mut process) != 0 {
+            nanvix::log!("failed to get process statistics");
+            return false;
+        }
+
+        if process.user_cycles < after.user_cycles {
+            nanvix::log!("inconsistent process statistics");
+            return false;
+        }
+    }
+
+    true
+}
+
+fn test_thread_rt() -> bool {
+    let tid: Tid = pm::thread_getid();
+    let mut info: pm::ThreadRt = pm::ThreadRt::default();
+    let params: pm::ThreadRt = pm::ThreadRt {
+        period: 10,
+        budget: 2,
+        deadline: 5,
+    };
+
+    if pm::thread_setrt(tid, &params) != 0 {
+        nanvix::log!("failed to set real-time parameters");
+        return false;
+    }
+
+    if (pm::thread_getrt(tid, &mut info) != 0) || (info != params) {
+        nanvix::log!("real-time parameters were not updated");
+        return false;
+    }
+
+    // Budget longer than the deadline.
+    let invalid: pm::ThreadRt = pm::ThreadRt {
+        period: 10,
+        budget: 6,
+        deadline: 5,
+    };
+    if pm::thread_setrt(tid, &invalid) >= 0 {
+        nanvix::log!("succeeded to set invalid real-time parameters");
+        return false;
+    }
+
+    // A full core is never admitted.
+    let full: pm::ThreadRt = pm::ThreadRt {
+        period: 10,
+        budget: 10,
+        deadline: 10,
+    };
+    if pm::thread_setrt(tid, &full) >= 0 {
+        nanvix::log!("succeeded to overcommit real-time threads");
+        return false;
+    }
+
+    // Parameters are left unchanged on failure.
+    if (pm::thread_getrt(tid, &mut info) != 0) || (info != params) {
+        nanvix::log!("real-time parameters were lost");
+        return false;
+    }
+
+    if pm::thread_setrt(tid, &pm::ThreadRt::default()) != 0 {
+        nanvix::log!("failed to leave real-time class");
+        return false;
+    }
+
+    if (pm::thread_getrt(tid, &mut info) != 0) || (info.period != 0) {
+        nanvix::log!("thread did not leave real-time class");
+        return false;
+    }
+
+    true
+}
+
+fn test_process_share() -> bool {
+    let pid: pm::Pid = kinfo::process_getid();
+    let mut info: pm::ThreadShare = pm::ThreadShare::default();
+    let mut before: pm::ThreadStats = pm::ThreadStats::default();
+    let mut after: pm::ThreadStats = pm::ThreadStats::default();
+
+    if (pm::process_getshare(pid, &mut info) != 0)
+        || (info.weight != pm::THREAD_SHARE_WEIGHT_DEFAULT)
+        || (info.quota != 0)
+    {
+        nanvix::log!("unexpected default fair share parameters");
+        return false;
+    }
+
+    // Zero weight.
+    let invalid: pm::ThreadShare = pm::ThreadShare {
+        weight: 0,
+        quota: 0,
+        period: 0,
+    };
+    if pm::process_setshare(pid, &invalid) >= 0 {
+        nanvix::log!("succeeded to set invalid fair share parameters");
+        return false;
+    }
+
+    let capped: pm::ThreadShare = pm::ThreadShare {
+        weight: 2 * pm::THREAD_SHARE_WEIGHT_DEFAULT,
+        quota: 2,
+        period: 10,
+    };
+    if pm::process_setshare(pid, &capped) != 0 {
+        nanvix::log!("failed to set fair share parameters");
+        return false;
+    }
+
+    if (pm::process_getshare(pid, &mut info) != 0) || (info != capped) {
+        nanvix::log!("fair share parameters were not updated");
+        return false;
+    }
+
+    if pm::process_stats(pid, &mut before) != 0 {
+        nanvix::log!("failed to get process statistics");
+        return false;
+    }
+
+    // Spin, so that the quota is overrun.
+    let start: u64 = kinfo::ticks();
+    while kinfo::ticks() < (start + 25) {
+        core::hint::spin_loop();
+    }
+
+    if pm::process_stats(pid, &mut after) != 0 {
+        nanvix::log!("failed to get process statistics");
+        return false;
+    }
+
+    let uncapped: pm::ThreadShare = pm::ThreadShare {
+        weight: pm::THREAD_SHARE_WEIGHT_DEFAULT,
+        quota: 0,
+        period: 0,
+    };
+    if pm::process_setshare(pid, &uncapped) != 0 {
+        nanvix::log!("failed to lift the cap");
+        return false;
+    }
+
+    if after.throttles <= before.throttles {
+        nanvix::log!("process was not throttled");
+        return false;
+    }
+
+    true
+}
+
+fn test_sched_affinity() -> bool {
+    let old: i32 = pm::sched_affinity(4);
+    if old < 0 {
+        nanvix::log!("failed to set address space affinity");
+        return false;
+    }
+
+    if pm::sched_affinity(pm::THREAD_AFFINITY_MAX + 1) >= 0 {
+        nanvix::log!("succeeded to set invalid address space affinity");
+        return false;
+    }
+
+    // Threads of this process still run under address space affinity.
+    pm::thread_yield();
+
+    if pm::sched_affinity(old as u32) != 4 {
+        nanvix::log!("address space affinity was not updated");
+        return false;
+    }
+
+    true
+}
+
+fn test_thread_quantum() -> bool {
+    let tid: Tid = pm::thread_getid();
+    let mut info: pm::ThreadQuantum = pm::ThreadQuantum::default();
+
+    if pm::thread_setquantum(tid, pm::THREAD_QUANTUM_MIN) != 0 {
+        nanvix::log!("failed to set thread quantum");
+        return false;
+    }
+
+    // Yield, so that at least one time slice is used.
+    pm::thread_yield();
+
+    if pm::thread_getquantum(tid, &mut info) != 0 {
+        nanvix::log!("failed to get thread quantum");
+        return false;
+    }
+
+    if (info.quantum != pm::THREAD_QUANTUM_MIN) || (info.adaptive != 0) {
+        nanvix::log!("thread quantum was not updated");
+        return false;
+    }
+
+    if (info.slices_used == 0) || (info.slices_expired > info.slices_used) {
+        nanvix::log!("inconsistent time slice counters");
+        return false;
+    }
+
+    if pm::thread_setquantum(tid, pm::THREAD_QUANTUM_MAX + 1) >= 0 {
+        nanvix::log!("succeeded to set invalid thread quantum");
+        return false;
+    }
+
+    if pm::thread_setquantum(tid, pm::THREAD_QUANTUM_ADAPTIVE) != 0 {
+        nanvix::log!("failed to set adaptive thread quantum");
+        return false;
+    }
+
+    if (pm::thread_getquantum(tid, &mut info) != 0) || (info.adaptive == 0) {
+        nanvix::log!("thread quantum is not adaptive");
+        return false;
+    }
+
+    if pm::thread_setquantum(tid, pm::THREAD_QUANTUM_DEFAULT) != 0 {
+        nanvix::log!("failed to restore thread quantum");
+        return false;
+    }
+
+    true
+}
+
+fn thread_fpu_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    let mut x: f64 = core::hint::black_box(arg as u32 as f64);
+    for _ in 0..8 {
+        x = core::hint::black_box(x * 1.5);
+        pm::thread_yield();
+    }
+    (x as u32) as *mut ffi::c_void
+}
+
+fn test_thread_fpu() -> bool {
+    let mut x: f64 = core::hint::black_box(2.0);
+    let tid: Tid = pm::thread_create(thread_fpu_test, 256 as *mut ffi::c_void);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+
+    // Interleave floating-point computations with the other thread.
+    for _ in 0..8 {
+        x = core::hint::black_box(x * 0.5);
+        pm::thread_yield();
+    }
+
+    let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+    if pm::thread_join(tid, &mut retval) != 0 {
+        nanvix::log!("failed to join thread");
+        return false;
+    }
+
+    // 256 * 1.5^8 = 6561 and 2 * 0.5^8 = 1/128.
+    if ((retval as u32) != 6561) || (x != (1.0 / 128.0)) {
+        nanvix::log!("floating-point state was not preserved");
+        return false;
+    }
+
+    true
+}
+
+nanvix::thread_local!(static TLS_COUNTER = 0;);
+
+/// TLS block of the main thread.
+static mut MAIN_TLS: pm::TlsBlock = pm::TlsBlock::new();
+
+fn thread_tls_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    // Threads start with a TLS block of their own.
+    if TLS_COUNTER.get() != 0 {
+        return core::ptr::null_mut();
+    }
+
+    TLS_COUNTER.set(arg as usize);
+    for _ in 0..4 {
+        pm::thread_yield();
+        TLS_COUNTER.set(TLS_COUNTER.get() + 1);
+    }
+
+    TLS_COUNTER.get() as *mut ffi::c_void
+}
+
+fn test_thread_tls() -> bool {
+    let block: &mut pm::TlsBlock =
+        unsafe { &mut *core::ptr::addr_of_mut!(MAIN_TLS) };
+
+    if pm::thread_settls(block) != 0 {
+        nanvix::log!("failed to set thread-local storage");
+        return false;
+    }
+
+    if pm::tls_block() != (block as *mut pm::TlsBlock) {
+        nanvix::log!("thread-local storage was not loaded");
+        return false;
+    }
+
+    TLS_COUNTER.set(1);
+    let tid: Tid = pm::thread_create(thread_tls_test, 64 as *mut ffi::c_void);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+
+    // Interleave updates with the other thread.
+    for _ in 0..4 {
+        pm::thread_yield();
+        TLS_COUNTER.set(TLS_COUNTER.get() * 2);
+    }
+
+    let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+    if pm::thread_join(tid, &mut retval) != 0 {
+        nanvix::log!("failed to join thread");
+        return false;
+    }
+
+    if ((retval as usize) != 68) || (TLS_COUNTER.get() != 16) {
+        nanvix::log!("thread-local storage was not preserved");
+        return false;
+    }
+
+    true
+}
+
+fn thread_recycle_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    arg
+}
+
+fn test_thread_recycle() -> bool {
+    const ROUNDS: usize = 8;
+    const BATCH: usize = 8;
+
+    // Create more threads than fit at once, so that thread IDs and control
+    // blocks are recycled.
+    for round in 0..ROUNDS {
+        let mut tids: [Tid; BATCH] = [-1; BATCH];
+        for (i, tid) in tids.iter_mut().enumerate() {
+            let arg: *mut ffi::c_void = (round * BATCH + i) as *mut ffi::c_void;
+            *tid = pm::thread_create(thread_recycle_test, arg);
+            if *tid < 0 {
+                nanvix::log!("failed to create thread");
+                return false;
+            }
+        }
+
+        for (i, tid) in tids.iter().enumerate() {
+            let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+            if pm::thread_join(*tid, &mut retval) != 0 {
+                nanvix::log!("failed to join thread");
+                return false;
+            }
+            if (retval as usize) != (round * BATCH + i) {
+                nanvix::log!("unexpected thread return value");
+                return false;
+            }
+        }
+    }
+
+    true
+}
+
+fn stack_touch(depth: u32) -> u32 {
+    // Each call takes about one kilobyte of stack.
+    let buf: [u8; 1024] = core::hint::black_box([depth as u8; 1024]);
+    if depth == 0 {
+        return buf[0] as u32;
+    }
+    (buf[buf.len() - 1] as u32) + stack_touch(depth - 1)
+}
+
+fn thread_stack_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    stack_touch(arg as u32) as *mut ffi::c_void
+}
+
+fn test_thread_stack() -> bool {
+    const DEPTH: u32 = 16;
+    const EXPECTED: u32 = DEPTH * (DEPTH + 1) / 2;
+    let arg: *mut ffi::c_void = DEPTH as *mut ffi::c_void;
+    let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+
+    // The stack grows on demand, within its reserved size.
+    let tid: Tid =
+        pm::thread_create_with_stack(thread_stack_test, arg, 8 * 4096);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+    if (pm::thread_join(tid, &mut retval) != 0) || (retval as u32 != EXPECTED) {
+        nanvix::log!("thread did not grow its stack");
+        return false;
+    }
+
+    // A thread that overflows its stack is terminated.
+    let tid: Tid = pm::thread_create_with_stack(thread_stack_test, arg, 4096);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+    retval = core::ptr::null_mut();
+    if (pm::thread_join(tid, &mut retval) != 0) || !retval.is_null() {
+        nanvix::log!("stack overflow was not caught");
+        return false;
+    }
+
+    let tid: Tid = pm::thread_create_with_stack(
+        thread_stack_test,
+        arg,
+        pm::THREAD_STACK_SIZE_MAX + 4096,
+    );
+    if tid >= 0 {
+        nanvix::log!("succeeded to create thread with invalid stack size");
+        return false;
+    }
+
+    true
+}
+
+fn thread_yield_to_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    arg
+}
+
+fn test_thread_yield_to() -> bool {
+    let arg: *mut ffi::c_void = THREAD_ARG_VAL as *mut ffi::c_void;
+    let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+
+    let tid: Tid = pm::thread_create(thread_yield_to_test, arg);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+
+    // The new thread is ready, thus it runs right away.
+    if pm::thread_yield_to(tid) != 0 {
+        nanvix::log!("failed to yield to thread");
+        return false;
+    }
+
+    if pm::thread_yield_to(kinfo::thread_getid()) >= 0 {
+        nanvix::log!("succeeded to yield to self");
+        return false;
+    }
+    if pm::thread_yield_to(-1) >= 0 {
+        nanvix::log!("succeeded to yield to invalid thread");
+        return false;
+    }
+
+    if (pm::thread_join(tid, &mut retval) != 0) || (retval != arg) {
+        nanvix::log!("failed to join thread");
+        return false;
+    }
+
+    true
+}
+
+fn thread_sleep_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
+    pm::sleep(5);
+    arg
+}
+
+fn test_thread_sleep() -> bool {
+    let arg: *mut ffi::c_void = THREAD_ARG_VAL as *mut ffi::c_void;
+    let mut retval: *mut ffi::c_void = core::ptr::null_mut();
+
+    let start: u64 = kinfo::ticks();
+    if pm::sleep(2) != 0 {
+        nanvix::log!("failed to sleep");
+        return false;
+    }
+
+    if kinfo::ticks() < (start + 2) {
+        nanvix::log!("woke up too early");
+        return false;
+    }
+
+    let tid: Tid = pm::thread_create(thread_sleep_test, arg);
+    if tid < 0 {
+        nanvix::log!("failed to create thread");
+        return false;
+    }
+
+    // The new thread has not terminated yet.
+    if pm::thread_join_timeout(tid, &mut retval, 0) >= 0 {
+        nanvix::log!("succeeded to join a sleeping thread");
+        return false;
+    }
+
+    if (pm::thread_join_timeout(tid, &mut retval, pm::TIMEOUT_INFINITE) != 0)
+        || (retval != arg)
+    {
+        nanvix::log!("failed to join thread");
+        return false;
+    }
+
+    true
+}
+
+fn test_thread_sleep_long() -> bool {
+    // Timeouts of these lengths are cascaded from upper levels of the timer
+    // wheel before they expire.
+    const DELAYS: [u32; 2] = [127, 191];
+    const SLACK: u64 = 16;
+
+    for delay in DELAYS {
+        let start: u64 = kinfo::ticks();
+        if pm::sleep(delay) != 0 {
+            nanvix::log!("failed to sleep");
+            return false;
+        }
+
+        let elapsed: u64 = kinfo::ticks() - start;
+        if elapsed < (delay as u64) {
+            nanvix::log!("woke up too early");
+            return false;
+        }
+        if elapsed > (delay as u64) + SLACK {
+            nanvix::log!("woke up too late ({} ticks)", elapsed);
+            return false;
+        }
+    }
+
+    true
+}
+
 fn thread_multijoin_test(arg: *mut ffi::c_void) -> *mut ffi::c_void {
     let mut retval: *mut ffi::c_void = core::ptr::null_mut();
     let tid = pm::thread_getid();
@@ -550,6 +1467,12 @@ pub fn test_kernel_calls() {
     test!(issue_void2_kcall());
     test!(issue_void3_kcall());
     test!(issue_void4_kcall());
+    test!(issue_void5_kcall());
+    test!(issue_kcall_batch());
+    test!(issue_blocking_kcall_batch());
+    test!(issue_memory_kcall_batch());
+    test!(get_kcall_stats());
+    test!(write_large_buffer());
     test!(alloc_free_frame());
     test!(free_null_frame());
     test!(free_invalid_frame());
@@ -557,6 +1480,7 @@ pub fn test_kernel_calls() {
     test!(create_remove_vmem());
     test!(remove_null_vmem());
     test!(map_unmap_vmem());
+    test!(unmap_kinfo_page());
     test!(check_sizes());
     test!(change_page_permissions());
     test!(get_kmod_info());
@@ -565,6 +1489,20 @@ pub fn test_kernel_calls() {
     test!(test_semop_call());
     test!(test_semctl_call());
     test!(test_mailbox_tag());
+    test!(read_kernel_info());
     test!(test_thread_getid());
     test!(test_thread_create());
+    test!(test_thread_prio());
+    test!(test_thread_quantum());
+    test!(test_thread_stats());
+    test!(test_thread_rt());
+    test!(test_sched_affinity());
+    test!(test_process_share());
+    test!(test_thread_fpu());
+    test!(test_thread_tls());
+    test!(test_thread_recycle());
+    test!(test_thread_stack());
+    test!(test_thread_yield_to());
+    test!(test_thread_sleep());
+    test!(test_thread_sleep_long());
 }